@@ -0,0 +1,95 @@
+#pragma once
+#include "core/long.h"
+#include "core/real.h"
+
+// Binary floating point of arbitrary precision, in the spirit of MPFR:
+//
+//     BigFloat two(2, 256);                                    // 256 bits
+//     BigFloat r = sqrt(two);                                  // rounded to nearest
+//     BigFloat q = div(BigFloat(1), r, 1000, BigFloat::down);  // 1000 bits, toward -inf
+//
+// The value is m * 2^e with an integer mantissa of at most prec bits.
+// Every operation works out enough of the exact result (all of it, plus a
+// sticky bit for what is cut off) to round correctly in the requested mode.
+// The mantissa is a Long: products go through its multiplication, quotients
+// and roots through Real's Newton iterations (reciprocal, rsqrt) checked by
+// a remainder, and shifts are Long's, one product each at length.
+class BigFloat
+{
+public:
+	enum Rounding
+	{
+		nearest,     // ties to even
+		toward_zero,
+		up,          // toward +infinity
+		down,        // toward -infinity
+		away         // away from zero
+	};
+
+	static const uint default_prec = 53;
+
+private:
+	Long m;      // carries the sign; |m| < 2^prec
+	long long e;
+	uint prec;
+
+	// |x| * 2^k and |x| / 2^k; sticky is set when the shift drops a nonzero bit
+	static Long shl(const Long& x, ull k);
+	static Long shr(const Long& x, ull k, bool& sticky);
+	// sign * (|mant| + a bit of something when sticky) * 2^exp, rounded to p bits
+	static BigFloat round(Long mant, long long exp, bool sticky, uint p, Rounding r);
+
+public:
+	BigFloat(); // zero
+	BigFloat(double v, uint prec = default_prec, Rounding r = nearest);
+	BigFloat(const Long& v, uint prec = default_prec, Rounding r = nearest);
+	explicit BigFloat(const Real& v, uint prec = default_prec, Rounding r = nearest);
+
+	uint precision() const { return prec; }
+	long long exponent() const { return e; }
+	const Long& mantissa() const { return m; }
+	bool is_zero() const { return m.is_zero(); }
+	int sign() const { return m.is_zero() ? 0 : (m < null ? -1 : 1); }
+
+	// rounds to p bits; more bits keep the value as it is
+	BigFloat& set_precision(uint p, Rounding r = nearest);
+
+	double to_double() const;
+	Long to_long() const;                      // toward zero
+	std::string to_string(uint digits = 0) const; // truncated to digits significant digits (never inside the integer part); 0: exact
+
+	int compare(const BigFloat& b) const;      // -1, 0, 1
+	bool operator==(const BigFloat& b) const { return compare(b) == 0; }
+	bool operator!=(const BigFloat& b) const { return compare(b) != 0; }
+	bool operator<(const BigFloat& b) const { return compare(b) < 0; }
+	bool operator>(const BigFloat& b) const { return compare(b) > 0; }
+	bool operator<=(const BigFloat& b) const { return compare(b) <= 0; }
+	bool operator>=(const BigFloat& b) const { return compare(b) >= 0; }
+
+	// the operators round to nearest at the larger precision of the two
+	BigFloat operator-() const;
+	BigFloat operator+(const BigFloat& b) const;
+	BigFloat operator-(const BigFloat& b) const;
+	BigFloat operator*(const BigFloat& b) const;
+	BigFloat operator/(const BigFloat& b) const;
+	BigFloat& operator+=(const BigFloat& b) { return *this = *this + b; }
+	BigFloat& operator-=(const BigFloat& b) { return *this = *this - b; }
+	BigFloat& operator*=(const BigFloat& b) { return *this = *this * b; }
+	BigFloat& operator/=(const BigFloat& b) { return *this = *this / b; }
+
+	friend BigFloat add(const BigFloat& a, const BigFloat& b, uint prec, Rounding r);
+	friend BigFloat mul(const BigFloat& a, const BigFloat& b, uint prec, Rounding r);
+	friend BigFloat div(const BigFloat& a, const BigFloat& b, uint prec, Rounding r);
+	friend BigFloat sqrt(const BigFloat& a, uint prec, Rounding r);
+	friend BigFloat ldexp(const BigFloat& a, long long k);
+};
+
+BigFloat add(const BigFloat& a, const BigFloat& b, uint prec, BigFloat::Rounding r = BigFloat::nearest);
+BigFloat sub(const BigFloat& a, const BigFloat& b, uint prec, BigFloat::Rounding r = BigFloat::nearest);
+BigFloat mul(const BigFloat& a, const BigFloat& b, uint prec, BigFloat::Rounding r = BigFloat::nearest);
+BigFloat div(const BigFloat& a, const BigFloat& b, uint prec, BigFloat::Rounding r = BigFloat::nearest);
+BigFloat sqrt(const BigFloat& a, uint prec, BigFloat::Rounding r = BigFloat::nearest);
+BigFloat sqrt(const BigFloat& a);          // at the precision of a
+BigFloat ldexp(const BigFloat& a, long long k); // a * 2^k, exact
+
+std::ostream& operator<<(std::ostream& stream, const BigFloat& x);
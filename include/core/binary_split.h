@@ -0,0 +1,74 @@
+#pragma once
+#include "core/long_accum.h"
+#include <type_traits>
+
+// Binary splitting (Haible and Papanikolaou) of a series with small integer
+// terms, for constants.cpp and elementary.cpp:
+//
+//     sum over k in [n1, n2) of a(k) / b(k) * p(n1)...p(k) / (q(n1)...q(k) base^(d (k - n1 + 1)))
+//
+// is one fraction T / (B Q base^(d (n2 - n1))) whose halves are built the
+// same way, so almost all the work is in the few products near the top,
+// where Long is fastest. The powers of base are limb shifts, never products,
+// and an a or b given as unit_term drops out of the products altogether.
+struct unit_term
+{
+	Long operator()(ull) const { return pone; }
+};
+
+struct SplitSum
+{
+	Long P, Q, B, T;
+};
+
+// runs of terms this short are summed directly instead of split further
+inline constexpr ull split_leaf_terms = 8;
+
+// the terms [n1, n2) one by one: term i is a(i) p(n1)...p(i) q(i + 1)...q(n2 - 1)
+// times the b(j) other than b(i), shifted by d (n2 - 1 - i) limbs, all
+// added in place with one carry pass
+template <class Fa, class Fb, class Fp, class Fq>
+SplitSum split_leaf(const Fa& a, const Fb& b, const Fp& p, const Fq& q, uint d, ull n1, ull n2)
+{
+	constexpr bool has_a = !std::is_same<Fa, unit_term>::value, has_b = !std::is_same<Fb, unit_term>::value;
+	size_t n = n2 - n1;
+	vector<Long> bv(has_b ? n : 0, null), bs(n + 1, pone), qs(n + 1, pone); // suffix products of b and q
+	for (size_t i = n; i-- > 0; ) {
+		if constexpr (has_b) {
+			bv[i] = b(n1 + i);
+			bs[i] = bv[i] * bs[i + 1];
+		}
+		qs[i] = q(n1 + i) * qs[i + 1];
+	}
+	LongAccumulator t;
+	Long P = pone, bp = pone; // prefix products of p and b
+	for (size_t i = 0; i < n; ++i) {
+		P = P * p(n1 + i);
+		Long u = P * qs[i + 1];
+		if constexpr (has_b)
+			u = bp * bs[i + 1] * u;
+		if constexpr (has_a)
+			u = a(n1 + i) * u;
+		t.add(u, 1, d * (uint)(n - 1 - i));
+		if constexpr (has_b)
+			bp = bp * bv[i];
+	}
+	return { P, qs[0], bs[0], t.value() };
+}
+
+// the terms [n1, n2)
+template <class Fa, class Fb, class Fp, class Fq>
+SplitSum binary_split(const Fa& a, const Fb& b, const Fp& p, const Fq& q, uint d, ull n1, ull n2)
+{
+	if (n2 - n1 <= split_leaf_terms)
+		return split_leaf(a, b, p, q, d, n1, n2);
+	ull m = (n1 + n2) / 2;
+	SplitSum l = binary_split(a, b, p, q, d, n1, m), r = binary_split(a, b, p, q, d, m, n2);
+	Long lt = l.T * r.Q, rt = l.P * r.T;
+	if constexpr (!std::is_same<Fb, unit_term>::value) {
+		lt = r.B * lt;
+		rt = l.B * rt;
+	}
+	lt.shift(d * (uint)(n2 - m));
+	return { l.P * r.P, l.Q * r.Q, l.B * r.B, lt + rt };
+}
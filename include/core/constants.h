@@ -0,0 +1,18 @@
+#pragma once
+#include "core/real.h"
+
+// Constants to any number of decimal places (truncated, the last one may be
+// one low). The series are summed by binary splitting, so the work is a few
+// big products and one reciprocal. Each constant keeps its longest result:
+// asking again for no more places only cuts that one down.
+//
+//     Real pi = compute_pi(1000000);
+//     std::cout << compute_pi(50);    // free now
+
+Real compute_pi(uint digits);     // Chudnovsky
+Real compute_e(uint digits);      // sum of 1 / k!
+Real compute_log2(uint digits);   // 2/3 sum of 1 / ((2k + 1) 9^k), i.e. 2 atanh(1/3)
+Real compute_sqrt2(uint digits);  // Newton on 1 / sqrt(2)
+
+// x / 10^(x.get_mant() - digits), rounded down: x with only that many places
+Real truncate(const Real& x, uint digits);
@@ -0,0 +1,22 @@
+#pragma once
+#include "core/real.h"
+
+// Elementary functions of a Real to the given number of decimal places
+// (truncated, the last one may be a unit or two off). The argument is
+// reduced first: by multiples of log 2 for exp, of pi / 2 for sin and cos,
+// and by powers of 2 for log. What is left is cut into chunks of 1, 2, 4, ...
+// limbs whose series are summed by binary splitting (the bit-burst method),
+// so the cost grows like a few products at the full precision times the log
+// of it. log and atan invert exp and sin / cos by Newton's iteration,
+// doubling the precision at each step.
+//
+//     Real x(Long(5), 1);        // 0.5
+//     Real y = exp(x, 1000);     // 1.6487212707...
+//     Real z = atan(x, 50);
+
+Real exp(const Real& x, uint digits);
+Real log(const Real& x, uint digits);                 // x > 0
+Real sin(const Real& x, uint digits);
+Real cos(const Real& x, uint digits);
+Real atan(const Real& x, uint digits);
+Real pow(const Real& x, const Real& y, uint digits);  // x < 0 only with an integer y
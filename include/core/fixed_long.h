@@ -0,0 +1,388 @@
+#pragma once
+#include "core/long.h"
+#include <array>
+#include <cmath>
+#include <stdexcept>
+
+// Unsigned integer of a fixed number of bits, for bounded modular work
+// (256 .. 4096-bit moduli):
+//
+//     FixedLong<512> n(Long("...")), a(2);
+//     FixedLong<512> r = pow_mod(a, n - 1, n);   // Montgomery, n odd
+//     Long back = r.to_long();
+//
+// Binary 64-bit words, lowest first, in a std::array: no heap and no sign;
+// +, - and * wrap modulo 2^Bits. Every loop runs a compile-time number of
+// times, so the compiler unrolls it and keeps small operands in registers.
+
+// lo + x * y + carry; the high word goes back into carry
+constexpr ull fixed_mac(ull lo, ull x, ull y, ull& carry)
+{
+#ifdef __SIZEOF_INT128__
+	unsigned __int128 t = (unsigned __int128)x * y + lo + carry;
+	carry = (ull)(t >> 64);
+	return (ull)t;
+#else
+	ull xl = x & 0xffffffff, xh = x >> 32, yl = y & 0xffffffff, yh = y >> 32;
+	ull ll = xl * yl, lh = xl * yh, hl = xh * yl;
+	ull mid = (ll >> 32) + (lh & 0xffffffff) + (hl & 0xffffffff);
+	ull l = (ll & 0xffffffff) | (mid << 32);
+	ull h = xh * yh + (lh >> 32) + (hl >> 32) + (mid >> 32);
+	l += lo;
+	h += l < lo;
+	l += carry;
+	h += l < carry;
+	carry = h;
+	return l;
+#endif
+}
+
+template <unsigned Bits>
+class FixedLong
+{
+	static_assert(Bits > 0 && Bits % 64 == 0, "FixedLong: Bits must be a positive multiple of 64");
+
+public:
+	static constexpr unsigned words = Bits / 64;
+
+private:
+	std::array<ull, words> w;
+
+public:
+	constexpr FixedLong() : w() {}
+	constexpr FixedLong(ull v) : w() { w[0] = v; }
+	explicit FixedLong(const Long& x);
+
+	Long to_long() const;
+	explicit operator Long() const { return to_long(); }
+
+	constexpr ull& operator[](unsigned i) { return w[i]; }
+	constexpr ull operator[](unsigned i) const { return w[i]; }
+
+	// in place, return the carry / borrow out of the top word
+	constexpr ull add(const FixedLong& y)
+	{
+		ull c = 0;
+		for (unsigned i = 0; i < words; ++i) {
+			ull s = w[i] + c;
+			c = s < c;
+			w[i] = s + y.w[i];
+			c += w[i] < s;
+		}
+		return c;
+	}
+	constexpr ull sub(const FixedLong& y)
+	{
+		ull b = 0;
+		for (unsigned i = 0; i < words; ++i) {
+			ull d = w[i] - y.w[i];
+			ull b1 = w[i] < y.w[i];
+			w[i] = d - b;
+			b = b1 | (d < b);
+		}
+		return b;
+	}
+
+	// the full product, 2 * Bits wide
+	constexpr FixedLong<2 * Bits> mul_wide(const FixedLong& y) const
+	{
+		FixedLong<2 * Bits> r;
+		for (unsigned i = 0; i < words; ++i) {
+			ull c = 0;
+			for (unsigned j = 0; j < words; ++j)
+				r[i + j] = fixed_mac(r[i + j], w[i], y.w[j], c);
+			r[i + words] = c;
+		}
+		return r;
+	}
+
+	// only the words that stay below 2^Bits
+	constexpr FixedLong mul_low(const FixedLong& y) const
+	{
+		FixedLong r;
+		for (unsigned i = 0; i < words; ++i) {
+			ull c = 0;
+			for (unsigned j = 0; i + j < words; ++j)
+				r.w[i + j] = fixed_mac(r.w[i + j], w[i], y.w[j], c);
+		}
+		return r;
+	}
+
+	constexpr FixedLong& operator+=(const FixedLong& y) { add(y); return *this; }
+	constexpr FixedLong& operator-=(const FixedLong& y) { sub(y); return *this; }
+	constexpr FixedLong& operator*=(const FixedLong& y) { return *this = mul_low(y); }
+	constexpr FixedLong operator+(const FixedLong& y) const { FixedLong r = *this; r.add(y); return r; }
+	constexpr FixedLong operator-(const FixedLong& y) const { FixedLong r = *this; r.sub(y); return r; }
+	constexpr FixedLong operator*(const FixedLong& y) const { return mul_low(y); }
+
+	constexpr FixedLong operator<<(unsigned n) const
+	{
+		FixedLong r;
+		unsigned q = n / 64, s = n % 64;
+		for (unsigned i = words; i-- > q;) {
+			r.w[i] = w[i - q] << s;
+			if (s && i > q)
+				r.w[i] |= w[i - q - 1] >> (64 - s);
+		}
+		return r;
+	}
+	constexpr FixedLong operator>>(unsigned n) const
+	{
+		FixedLong r;
+		unsigned q = n / 64, s = n % 64;
+		for (unsigned i = 0; i + q < words; ++i) {
+			r.w[i] = w[i + q] >> s;
+			if (s && i + q + 1 < words)
+				r.w[i] |= w[i + q + 1] << (64 - s);
+		}
+		return r;
+	}
+
+	// -1, 0, 1
+	constexpr int compare(const FixedLong& y) const
+	{
+		for (unsigned i = words; i-- > 0;)
+			if (w[i] != y.w[i])
+				return w[i] < y.w[i] ? -1 : 1;
+		return 0;
+	}
+	constexpr bool operator==(const FixedLong& y) const { return compare(y) == 0; }
+	constexpr bool operator!=(const FixedLong& y) const { return compare(y) != 0; }
+	constexpr bool operator<(const FixedLong& y) const { return compare(y) < 0; }
+	constexpr bool operator>(const FixedLong& y) const { return compare(y) > 0; }
+	constexpr bool operator<=(const FixedLong& y) const { return compare(y) <= 0; }
+	constexpr bool operator>=(const FixedLong& y) const { return compare(y) >= 0; }
+
+	constexpr bool is_zero() const
+	{
+		for (unsigned i = 0; i < words; ++i)
+			if (w[i])
+				return false;
+		return true;
+	}
+	constexpr bool isodd() const { return w[0] & 1; }
+	constexpr bool test_bit(unsigned i) const { return (w[i / 64] >> (i % 64)) & 1; }
+	constexpr unsigned bit_length() const
+	{
+		for (unsigned i = words; i-- > 0;)
+			if (w[i])
+				return i * 64 + 64 - __builtin_clzll(w[i]);
+		return 0;
+	}
+
+	// this mod n by shift and subtract, one bit at a time; for setup, not
+	// for inner loops
+	constexpr FixedLong mod(const FixedLong& n) const
+	{
+		if (n.is_zero())
+			throw std::runtime_error("Division by zero!");
+		FixedLong r;
+		for (unsigned i = bit_length(); i-- > 0;) {
+			ull top = r.w[words - 1] >> 63;
+			r = r << 1;
+			r.w[0] |= test_bit(i);
+			if (top || r >= n)
+				r.sub(n);
+		}
+		return r;
+	}
+	constexpr FixedLong operator%(const FixedLong& n) const { return mod(n); }
+};
+
+template <unsigned Bits>
+FixedLong<Bits>::FixedLong(const Long& x) : w()
+{
+	if (x < null)
+		throw std::invalid_argument("FixedLong: negative value");
+	auto v = x.to_words();
+	if (v.size() > words)
+		throw std::overflow_error("FixedLong: value does not fit");
+	for (unsigned i = 0; i < v.size(); ++i)
+		w[i] = v[i];
+}
+
+template <unsigned Bits>
+Long FixedLong<Bits>::to_long() const
+{
+	return Long::from_words(vector<ull>(w.begin(), w.end()));
+}
+
+template <unsigned Bits>
+std::ostream& operator<<(std::ostream& stream, const FixedLong<Bits>& x)
+{
+	return stream << x.to_long();
+}
+
+// Arithmetic mod an odd n in Montgomery form, x * R mod n with R = 2^Bits.
+// mul() interleaves the product with the reduction (CIOS), one word of the
+// multiplier at a time.
+template <unsigned Bits>
+class Montgomery
+{
+	static constexpr unsigned words = FixedLong<Bits>::words;
+
+	FixedLong<Bits> n;
+	FixedLong<Bits> r1; // R mod n, the form of 1
+	FixedLong<Bits> r2; // R^2 mod n
+	ull ninv;           // -n^-1 mod 2^64
+
+public:
+	explicit constexpr Montgomery(const FixedLong<Bits>& modulus) : n(modulus), r1(), r2(), ninv(0)
+	{
+		if (!n.isodd())
+			throw std::invalid_argument("Montgomery: modulus must be odd");
+
+		// Newton: every step doubles the correct low bits, n * n = 1 mod 8
+		ull x = n[0];
+		for (int i = 0; i < 5; ++i)
+			x *= 2 - n[0] * x;
+		ninv = 0 - x;
+
+		r1 = (FixedLong<Bits>() - n).mod(n);
+		r2 = r1;
+		for (unsigned i = 0; i < Bits; ++i) {
+			ull top = r2[words - 1] >> 63;
+			r2 = r2 << 1;
+			if (top || r2 >= n)
+				r2.sub(n);
+		}
+	}
+
+	constexpr const FixedLong<Bits>& modulus() const { return n; }
+
+	// a * b / R mod n; a, b < n
+	constexpr FixedLong<Bits> mul(const FixedLong<Bits>& a, const FixedLong<Bits>& b) const
+	{
+		ull t[words + 2] = {};
+		for (unsigned i = 0; i < words; ++i) {
+			ull c = 0;
+			for (unsigned j = 0; j < words; ++j)
+				t[j] = fixed_mac(t[j], a[j], b[i], c);
+			t[words] += c;
+			t[words + 1] = t[words] < c;
+
+			ull m = t[0] * ninv;
+			c = 0;
+			fixed_mac(t[0], m, n[0], c);
+			for (unsigned j = 1; j < words; ++j)
+				t[j - 1] = fixed_mac(t[j], m, n[j], c);
+			t[words - 1] = t[words] + c;
+			t[words] = t[words + 1] + (t[words - 1] < c);
+		}
+		FixedLong<Bits> r;
+		for (unsigned j = 0; j < words; ++j)
+			r[j] = t[j];
+		if (t[words] || r >= n)
+			r.sub(n);
+		return r;
+	}
+
+	constexpr FixedLong<Bits> to(const FixedLong<Bits>& a) const { return mul(a < n ? a : a.mod(n), r2); }
+	constexpr FixedLong<Bits> from(const FixedLong<Bits>& a) const { return mul(a, FixedLong<Bits>(1)); }
+	constexpr const FixedLong<Bits>& one() const { return r1; }
+
+	// a^e mod n, both ends in ordinary form
+	constexpr FixedLong<Bits> pow(const FixedLong<Bits>& a, const FixedLong<Bits>& e) const { return from(pow_mont(a, e)); }
+
+	// a^e mod n in Montgomery form, a in ordinary form; fixed 4-bit window
+	constexpr FixedLong<Bits> pow_mont(const FixedLong<Bits>& a, const FixedLong<Bits>& e) const
+	{
+		FixedLong<Bits> table[16];
+		table[0] = r1;
+		table[1] = to(a);
+		for (unsigned k = 2; k < 16; ++k)
+			table[k] = mul(table[k - 1], table[1]);
+
+		FixedLong<Bits> x = r1;
+		unsigned bits = (e.bit_length() + 3) / 4 * 4;
+		for (unsigned i = bits; i > 0; i -= 4) {
+			if (i != bits)
+				for (int s = 0; s < 4; ++s)
+					x = mul(x, x);
+			unsigned k = (e[(i - 4) / 64] >> ((i - 4) % 64)) & 15;
+			if (k)
+				x = mul(x, table[k]);
+		}
+		return x;
+	}
+};
+
+template <unsigned Bits>
+FixedLong<Bits> pow_mod(const FixedLong<Bits>& a, const FixedLong<Bits>& e, const FixedLong<Bits>& n)
+{
+	if (!n.isodd()) // Montgomery needs an odd modulus
+		return FixedLong<Bits>(pow_mod(a.to_long(), e.to_long(), n.to_long()));
+	return Montgomery<Bits>(n).pow(a, e);
+}
+
+// Same contract as prtest_general: 2^-iter for a probable prime, -1 for a
+// composite. The random bases come from the Long generator.
+template <unsigned Bits, class Met>
+double prtest_fixed(const FixedLong<Bits>& p, ull iter, Met met)
+{
+	if (!p.isodd())
+		return p == FixedLong<Bits>(2) ? std::pow(0.5, (double)iter) : -1;
+	if (p == FixedLong<Bits>(1))
+		return -1;
+
+	Montgomery<Bits> mont(p);
+	Long lp = p.to_long();
+	double not_prime = 1.;
+	for (ull l = 0; l < iter && not_prime > 0.; ++l) {
+		Long a = rand(lp.size(), lp,
+			[](const auto& a, const auto& p)
+		{return a < p && a != null;}
+		);
+		not_prime = met(mont, FixedLong<Bits>(a)) ? not_prime * 0.5 : -1;
+	}
+	return not_prime;
+}
+
+template <unsigned Bits>
+double prtest_RabinMiller(const FixedLong<Bits>& p, ull iter)
+{
+	// p - 1 = 2^s * m, m odd
+	FixedLong<Bits> pm = p - FixedLong<Bits>(1);
+	unsigned s = 0;
+	while (s < Bits && !pm.test_bit(s))
+		++s;
+	FixedLong<Bits> m = pm >> s;
+	return prtest_fixed(p, iter, [&](const Montgomery<Bits>& mont, const FixedLong<Bits>& a) {
+		// compared in Montgomery form, the squarings never leave it
+		const FixedLong<Bits> one = mont.one(), minus_one = mont.to(pm);
+		FixedLong<Bits> z = mont.pow_mont(a, m);
+		if (z == one || z == minus_one)
+			return true;
+		for (unsigned j = 1; j < s; ++j) {
+			z = mont.mul(z, z);
+			if (z == minus_one)
+				return true;
+			if (z == one)
+				return false;
+		}
+		return false;
+	});
+}
+
+template <unsigned Bits>
+double prtest_Lehmann(const FixedLong<Bits>& p, ull iter)
+{
+	FixedLong<Bits> pm = p - FixedLong<Bits>(1);
+	FixedLong<Bits> half = pm >> 1;
+	return prtest_fixed(p, iter, [&](const Montgomery<Bits>& mont, const FixedLong<Bits>& a) {
+		FixedLong<Bits> z = mont.pow(a, half);
+		return z == FixedLong<Bits>(1) || z == pm;
+	});
+}
+
+template <unsigned Bits>
+double prtest_SolovStras(const FixedLong<Bits>& p, ull iter)
+{
+	FixedLong<Bits> pm = p - FixedLong<Bits>(1);
+	FixedLong<Bits> half = pm >> 1;
+	Long lp = p.to_long();
+	return prtest_fixed(p, iter, [&](const Montgomery<Bits>& mont, const FixedLong<Bits>& a) {
+		int jac = Jacobi(a.to_long(), lp);
+		return jac != 0 && mont.pow(a, half) == (jac == 1 ? FixedLong<Bits>(1) : pm);
+	});
+}
@@ -0,0 +1,61 @@
+#pragma once
+#include <cstddef>
+
+// Heap storage for Long limbs. Limbs that do not fit the inline buffer of a
+// limb_vector come from the allocator installed for the current thread
+// (by default a thread-local pool of power-of-two size classes). Every
+// block remembers the allocator it came from, so a Long may be freed on
+// any thread and after its allocator was replaced.
+
+class LimbAllocator
+{
+public:
+	virtual void* allocate(size_t bytes) = 0;
+	virtual void deallocate(void* p, size_t bytes) = 0;
+	virtual ~LimbAllocator() {}
+};
+
+LimbAllocator& heap_limb_allocator();   // operator new / delete
+LimbAllocator& pool_limb_allocator();   // size-class free lists, one set per thread
+
+LimbAllocator* get_limb_allocator();
+LimbAllocator* set_limb_allocator(LimbAllocator* alloc); // this thread only; returns the previous one
+
+// counters of the current thread
+struct LimbAllocStats
+{
+	size_t allocations; // limb buffers handed out
+	size_t releases;    // limb buffers given back
+	size_t system;      // of the allocations, the ones that reached operator new
+	size_t bytes;       // bytes handed out
+};
+const LimbAllocStats& limb_alloc_stats();
+void reset_limb_alloc_stats();
+
+void* limb_alloc(size_t bytes);
+void limb_free(void* p, size_t bytes);
+
+// Bump allocator for the current thread while in scope:
+//     { LongArena scope; ... }
+// The chunks are released when the scope ends and no limbs allocated in it
+// are alive any more; a Long that escapes the scope keeps them until it dies.
+class LongArena
+{
+	class State;
+	State* state;
+	LimbAllocator* prev;
+
+public:
+	explicit LongArena(size_t chunk = 1 << 16);
+	~LongArena();
+	LongArena(const LongArena&) = delete;
+	LongArena& operator=(const LongArena&) = delete;
+
+	size_t bytes_used() const;
+};
+
+struct LimbAlloc
+{
+	static void* allocate(size_t bytes) { return limb_alloc(bytes); }
+	static void deallocate(void* p, size_t bytes) { limb_free(p, bytes); }
+};
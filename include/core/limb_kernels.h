@@ -0,0 +1,34 @@
+#pragma once
+#include <cstddef>
+
+// Vector kernels on raw limb arrays (base limb_base, lowest limb first).
+// Inputs must be normalized, every limb below limb_base; r may alias x or y.
+// The implementation is picked once at run time from the CPU features:
+// AVX-512, AVX2, NEON or plain C++.
+
+typedef unsigned long long ull;
+
+const ull limb_base = 10000;
+
+ull limbs_add(ull* r, const ull* x, const ull* y, size_t n);   // r = x + y, returns the carry
+ull limbs_sub(ull* r, const ull* x, const ull* y, size_t n);   // r = x - y, returns the borrow
+ull limbs_mul_small(ull* r, const ull* x, size_t n, ull k);    // r = x * k, returns the carry; k < 2^32
+int limbs_cmp(const ull* x, const ull* y, size_t n);           // -1, 0, 1
+
+// One-word divisor with its reciprocal (Granlund-Montgomery): the quotient
+// of any c < 2^59 is the high half of c * inv, or one more.
+struct LimbDivisor
+{
+	ull d;
+	ull inv; // floor((2^64 - 1) / d)
+
+	explicit LimbDivisor(ull divisor) : d(divisor), inv(~0ull / divisor) {}
+};
+
+ull limbs_div_small(ull* q, const ull* x, size_t n, const LimbDivisor& d); // q = x / d, returns x mod d; d < 2^32
+ull limbs_mod_small(const ull* x, size_t n, ull d);                        // x mod d without a quotient; d > 0
+
+// "avx512", "avx2", "neon" or "scalar"
+const char* limb_kernels_isa();
+// switches to the given kernels (for benchmarks); false if the CPU lacks them
+bool limb_kernels_use(const char* isa);
@@ -10,6 +10,8 @@
 #include <utility>  // std::swap
 #include <algorithm>  // std::max
 #include "random/quad_con_gen.h"
+#include "core/small_vector.h"
+#include "core/limb_alloc.h"
 
 #define _USE_MATH_DEFINES
 #define PI 3.14159265358979323846
@@ -21,9 +23,12 @@ using std::swap;
 typedef unsigned int uint;
 typedef unsigned short ush;
 typedef unsigned long long ull;
+typedef SmallVector<ull, 8, LimbAlloc> limb_vector; // up to 8 limbs (32 digits) live inside the Long
+typedef SmallVector<long long, 8, LimbAlloc> signed_limbs; // limbs of any sign, carries not yet propagated
 
 class Long;
 class Real;
+template <class E> struct LongExpr;
 
 class Long
 {
@@ -33,45 +38,84 @@ protected:
 
 	Long();
     void clear();
-    Long set(ull v, bool s = true);
+	Long& set(ull v, bool s = true);
     ull set(uint i, ull v); // dangerous ! use normal after!
 
-	void insert(ull v = 0);
-	Long insert(vector<ull>);
-	Long normal();
+	friend struct LongLeaf;
+	friend class LongAccumulator;
 
-	vector<ull> a;   // 2383597  --->   a == { 7 , 9 , 5 , 3 ... 2 }
+	void insert(ull v = 0);
+	Long& insert(const vector<ull>& x);
+	Long& insert(const limb_vector& x);
+	Long& normal();
+	Long& normal_signed(signed_limbs& acc);
+	Long& add_abs(const Long& b);
+	Long& sub_abs(const Long& b); // |this| >= |b|, in place
+	ull div_abs_small(ull d);     // |this| /= d in place, returns the remainder; 0 < d < 2^32
+
+	limb_vector a;   // 2383597  --->   a == { 7 , 9 , 5 , 3 ... 2 }
 	static const ull karacnaive;
 	static const ull toom3naive;
 	static const ull strasnaive;
+	static const ull nttnaive;
 	
 public:
-	static const ull base;
-	static const uint bs; 
+	static constexpr ull base = 10000; // limb_base of limb_kernels.h
+	static constexpr uint bs = 4;       // decimal digits per limb
 
-	Long changeSign(int b = 3);
+	Long& changeSign(int b = 3);
 
-	const vector<ull>& container() const;
+	const limb_vector& container() const;
 	uint size() const;
 	uint real_size() const;
 
 	ull operator[](int i) const;
 	ull get_char(uint i) const;
 	void print(std::ostream & stream = std::cout) const;
+	// the digits of |this|, most significant first, through a fixed buffer; a point
+	// delim goes before the last point of them, with zeros in front when there are fewer
+	void write_digits(std::ostream & stream, uint point = 0, char delim = '.') const;
 
-	Long shift(uint n = 1);
-	Long shiftaccurate(uint n = 1);
-	Long shiftback(uint n = 1);
+	Long& shift(uint n = 1);
+	Long& shiftaccurate(uint n = 1);
+	Long& shiftback(uint n = 1);
 	Long sum(const Long& b) const;
 	Long neg(const Long& b) const;
 	Long mul(const Long& b) const;
+	Long mul_limb(ull k) const;
 	Long divide(const int b, Long& rem) const;
+	ull mod_small(ull d) const;   // |this| mod d, no quotient is built
+	// quotient truncated toward zero, signed sign * b.sign; rem = |this| mod |b|
 	Long divide(const Long& b, Long& rem) const;
 	Long divide2(const Long & b, Long& rem) const;
 	Long mult_inv(const Long& b) const;
 	Long karac_mul(const Long& b) const;
 	Long toomcook_mul(const Long & b) const;
 	Long strassen_mul(const Long & b) const; // using 2 threads! 
+	Long ntt_mul(const Long& b) const;       // exact at any size, 2 threads as well
+	static Long ntt_product(const ull* x, uint n, const ull* y, uint m); // |x| * |y| straight from base limbs, as ntt_mul
+	Long mul_high(const Long& b, uint drop) const; // (*this * b) / base^drop, at most one unit low; the dropped limbs are mostly not computed
+
+	// bit operations act on the magnitude; shifts keep the sign. The limbs are
+	// decimal: a shift by k < 6144 bits is k / 48 passes of O(n) each, a
+	// longer one a single product (x * 2^k, or x * 5^k less k digits), so
+	// O(M(n + k)). to_words and from_words, and with them popcount and & | ^,
+	// split in halves by such shifts: O(M(n) log n). test_bit(i) and ctz read
+	// words up from the bottom, O(n) per 48 bits below the answer
+	Long operator<<(uint n) const;
+	Long operator>>(uint n) const;
+	Long shift_right(uint n, bool& inexact) const; // >> n, inexact is set when a one bit falls off
+	Long operator&(const Long& other) const;
+	Long operator|(const Long& other) const;
+	Long operator^(const Long& other) const;
+	uint bit_length() const;
+	bool test_bit(uint i) const;
+	uint ctz() const;   // 0 for zero
+	uint popcount() const;
+	ull low_bits() const;   // magnitude mod 2^64
+	vector<ull> to_words() const;   // magnitude in 64-bit words, lowest first
+	static Long from_words(const vector<ull>& w);
+	static Long from_limbs(const ull* limbs, uint n, bool negative = false); // base limbs, lowest first
 	
 public:
 	Long(uint);
@@ -82,22 +126,25 @@ public:
 	Long(ull);
 	Long(const char*);
 	Long(const vector<ull>& x); // dangerous!
-
-	Long operator=(uint);
-	Long operator=(int);
-	Long operator=(long);
-	Long operator=(long long);
-	Long operator=(unsigned long);
-	Long operator=(ull);
-	Long operator=(const char *);
-	Long operator=(const vector<ull>& x); // dangerous!
+	template <class E> Long(const LongExpr<E>& e);   // see long_expr.h
+
+	Long& operator=(uint);
+	Long& operator=(int);
+	Long& operator=(long);
+	Long& operator=(long long);
+	Long& operator=(unsigned long);
+	Long& operator=(ull);
+	Long& operator=(const char *);
+	Long& operator=(const vector<ull>& x); // dangerous!
+	template <class E> Long& operator=(const LongExpr<E>& e);
 
 public:
 	Long(const Long &other);
-	Long(Long &&other);
+	Long(Long &&other) noexcept;
 	Long& operator=(const Long& other);
-	Long& operator=(Long&& other);
+	Long& operator=(Long&& other) noexcept;
 
+	Long operator-() const;
 	virtual Long operator+(const Long& other) const;
 	virtual Long operator-(const Long& other) const;
 	virtual Long operator*(const Long& other) const;
@@ -105,6 +152,18 @@ public:
 	Long operator/(const Long& other) const;
 	Long operator%(const Long& other) const;
 
+	Long& operator+=(const Long& other);
+	Long& operator-=(const Long& other);
+	Long& operator*=(const Long& other);
+	Long& operator/=(const int other);
+	Long& operator/=(const Long& other);
+	Long& operator%=(const Long& other);
+
+	// -1, 0, 1; the operators below are built on these
+	int compare(const Long& b) const;
+	int compare_abs(const Long& b) const;
+	bool is_zero() const;
+
 	bool operator<(const Long& other)  const;
 	bool operator>(const Long& other)  const;
 	bool operator<=(const Long& other) const;
@@ -117,9 +176,10 @@ public:
 	virtual ~Long();
 };
 
-const auto null = Long(0);
-const auto pone = Long(1);
-const auto mone = Long(-1);
+// one object each for the whole program, not one per translation unit
+inline const Long null = Long(0);
+inline const Long pone = Long(1);
+inline const Long mone = Long(-1);
 
 // even == chetnoe
 inline bool iseven(const Long & a) {
@@ -129,27 +189,36 @@ inline bool iseven(const Long & a) {
 inline bool isodd(const Long & a) {
     return (a[0] & 1);
 }
-std::ostream & operator<<(std::ostream & stream, Long b);
+std::ostream & operator<<(std::ostream & stream, const Long& b);
 
 Long rand(const uint s);
 Long rand(const uint s, const Long &c,
     bool(*condition)(const Long& a, const Long& b) = [](auto& a, auto& b) { (void)a; (void)b; return true; });
 
 Real inverse(const Long& a, uint iterations = 15);
+Real reciprocal(const Long& a, uint limbs); // 1 / a to limbs significant limbs
 Long abs(const Long& a);
 Long factorial(const Long& n);
 Long gcd(const Long& u, const Long& v);
 Long pow(const Long& u, const Long& v);
 Long pow_mod(const Long& a, const Long& pow, const Long& N);
 
+// product / remainder trees (Bernstein)
+vector<vector<Long>> product_tree(const vector<Long>& x);
+vector<Long> multi_mod(const Long& x, const vector<Long>& moduli);
+vector<Long> batch_gcd(const vector<Long>& x);
+
 double prtest_SolovStras(const Long & p, ull iter);
 double prtest_Lehmann(const Long & p, ull iter);
 double prtest_RabinMiller(const Long & p, ull iter);
 
-Long Jacobi(Long& a, Long& b);
+int Jacobi(const Long& a, const Long& n);
 
 std::string my_to_string(const ull& a, const int base);
 Long to_Long(const Real& a);
 
 // Utility function to read small primes from file
-std::vector<Long> load_small_primes(const std::string& filename = "data/small_primes.txt");
\ No newline at end of file
+std::vector<Long> load_small_primes(const std::string& filename = "data/small_primes.txt");
+
+#include "core/long_expr.h"
+#include "core/long_literal.h"
@@ -0,0 +1,58 @@
+#pragma once
+#include "core/long.h"
+
+// Running sum of many Long values with deferred carries:
+//
+//     LongAccumulator s;
+//     for (auto& t : terms)
+//         s += t;
+//     Long total = s.value();
+//
+// Terms are added limb by limb into signed 64-bit limbs (a plain loop the
+// compiler vectorizes); the carries are propagated once on read, or when
+// the limbs could overflow.
+class LongAccumulator
+{
+	signed_limbs acc;
+	ull pending; // sum of |coefficients| added since the last carry pass
+
+	void reserve_weight(ull w);
+
+public:
+	// limbs stay below base * max_weight, far from overflowing a long long
+	static const ull max_weight = (1ull << 62) / 10000;
+
+	LongAccumulator();
+	explicit LongAccumulator(const Long& x);
+
+	// this += k * x * base^shift, |k| <= max_weight
+	LongAccumulator& add(const Long& x, long long k = 1, uint shift = 0);
+	LongAccumulator& operator+=(const Long& x) { return add(x); }
+	LongAccumulator& operator-=(const Long& x) { return add(x, -1); }
+	template <class E> LongAccumulator& operator+=(const LongExpr<E>& e);
+	template <class E> LongAccumulator& operator-=(const LongExpr<E>& e);
+
+	void normalize(); // propagates the carries now
+	void clear();
+	Long value() const;
+};
+
+template <class E>
+LongAccumulator& LongAccumulator::operator+=(const LongExpr<E>& e)
+{
+	reserve_weight(e.self().weight());
+	if (acc.size() < e.self().limbs())
+		acc.resize(e.self().limbs(), 0);
+	e.self().accumulate(acc.data(), 1, 0);
+	return *this;
+}
+
+template <class E>
+LongAccumulator& LongAccumulator::operator-=(const LongExpr<E>& e)
+{
+	reserve_weight(e.self().weight());
+	if (acc.size() < e.self().limbs())
+		acc.resize(e.self().limbs(), 0);
+	e.self().accumulate(acc.data(), -1, 0);
+	return *this;
+}
@@ -0,0 +1,126 @@
+#pragma once
+// Lazy linear combinations of Long values.
+//
+//   Long c = lazy(x).shift(2 * k) + y + (lazy(z) - x - y).shift(k);
+//
+// builds an expression tree of references; nothing is computed until it is
+// assigned to a Long. Evaluation adds every leaf, multiplied by its small
+// coefficient and shifted by whole limbs, into one buffer of signed limbs
+// and propagates the carries in a single pass. The operands must outlive
+// the expression; the destination may be one of them.
+// Included at the end of long.h.
+
+template <class E> struct LongShift;
+
+template <class E>
+struct LongExpr
+{
+	const E& self() const { return static_cast<const E&>(*this); }
+	LongShift<E> shift(uint n) const;
+};
+
+struct LongLeaf : LongExpr<LongLeaf>
+{
+	const Long& x;
+	explicit LongLeaf(const Long& v) : x(v) {}
+
+	uint limbs() const { return x.size(); }
+	ull weight() const { return 1; }   // sum of |coefficients|, bounds the limb growth
+	void accumulate(long long* acc, long long coef, uint shift) const
+	{
+		if (x.sign != 1)
+			coef = -coef;
+		for (uint i = 0; i < x.size(); ++i)
+			acc[i + shift] += coef * (long long)x.a[i];
+	}
+};
+
+template <class L, class R, int S> // S: +1 sum, -1 difference
+struct LongSum : LongExpr<LongSum<L, R, S>>
+{
+	L l;
+	R r;
+	LongSum(const L& a, const R& b) : l(a), r(b) {}
+
+	uint limbs() const { return std::max(l.limbs(), r.limbs()); }
+	ull weight() const { return l.weight() + r.weight(); }
+	void accumulate(long long* acc, long long coef, uint shift) const
+	{
+		l.accumulate(acc, coef, shift);
+		r.accumulate(acc, S * coef, shift);
+	}
+};
+
+template <class E>
+struct LongScale : LongExpr<LongScale<E>>
+{
+	E e;
+	long long k;
+	LongScale(const E& v, long long m) : e(v), k(m) {}
+
+	uint limbs() const { return e.limbs(); }
+	ull weight() const { return e.weight() * (ull)(k < 0 ? -k : k); }
+	void accumulate(long long* acc, long long coef, uint shift) const
+	{
+		e.accumulate(acc, coef * k, shift);
+	}
+};
+
+template <class E>
+struct LongShift : LongExpr<LongShift<E>>
+{
+	E e;
+	uint n;
+	LongShift(const E& v, uint s) : e(v), n(s) {}
+
+	uint limbs() const { return e.limbs() + n; }
+	ull weight() const { return e.weight(); }
+	void accumulate(long long* acc, long long coef, uint shift) const
+	{
+		e.accumulate(acc, coef, shift + n);
+	}
+};
+
+template <class E>
+LongShift<E> LongExpr<E>::shift(uint n) const
+{
+	return LongShift<E>(self(), n);
+}
+
+inline LongLeaf lazy(const Long& x)
+{
+	return LongLeaf(x);
+}
+
+template <class L, class R>
+LongSum<L, R, 1> operator+(const LongExpr<L>& l, const LongExpr<R>& r) { return { l.self(), r.self() }; }
+template <class L, class R>
+LongSum<L, R, -1> operator-(const LongExpr<L>& l, const LongExpr<R>& r) { return { l.self(), r.self() }; }
+template <class L>
+LongSum<L, LongLeaf, 1> operator+(const LongExpr<L>& l, const Long& r) { return { l.self(), LongLeaf(r) }; }
+template <class L>
+LongSum<L, LongLeaf, -1> operator-(const LongExpr<L>& l, const Long& r) { return { l.self(), LongLeaf(r) }; }
+template <class R>
+LongSum<LongLeaf, R, 1> operator+(const Long& l, const LongExpr<R>& r) { return { LongLeaf(l), r.self() }; }
+template <class R>
+LongSum<LongLeaf, R, -1> operator-(const Long& l, const LongExpr<R>& r) { return { LongLeaf(l), r.self() }; }
+
+// coefficients must stay small: |k| * base times the number of terms fits a long long
+template <class E>
+LongScale<E> operator*(const LongExpr<E>& e, long long k) { return { e.self(), k }; }
+template <class E>
+LongScale<E> operator*(long long k, const LongExpr<E>& e) { return { e.self(), k }; }
+
+template <class E>
+Long::Long(const LongExpr<E>& e) : sign(1)
+{
+	operator=(e);
+}
+
+template <class E>
+Long& Long::operator=(const LongExpr<E>& e)
+{
+	signed_limbs acc(e.self().limbs(), 0);
+	e.self().accumulate(acc.data(), 1, 0);
+	return normal_signed(acc);
+}
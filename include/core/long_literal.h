@@ -0,0 +1,72 @@
+#pragma once
+// Long literals parsed at compile time:
+//
+//     const Long p = 170141183460469231731687303715884105727_L;
+//     const Long m = -0xffffffffffffffffffffffff_L;
+//
+// Decimal, 0x hex, 0b binary and 0 octal digits, with ' separators, are
+// turned into base limbs in a constexpr array during compilation; at run
+// time the literal only copies those limbs into a Long, there is no string
+// to parse. Long itself cannot be constexpr (its limbs may live on the
+// heap); FixedLong is the type for arithmetic at compile time.
+// Included at the end of long.h.
+
+template <size_t N>
+struct LongLimbs
+{
+	ull limb[N];
+	uint size;
+};
+
+constexpr uint long_literal_digit(char c)
+{
+	return (c >= 'a' && c <= 'f') ? c - 'a' + 10
+		: (c >= 'A' && c <= 'F') ? c - 'A' + 10
+		: (c >= '0' && c <= '9') ? c - '0'
+		: 99;
+}
+
+// every digit: limbs = limbs * radix + digit
+template <char... D>
+constexpr auto long_literal_limbs()
+{
+	constexpr char s[] = { D... };
+	constexpr size_t n = sizeof...(D);
+	LongLimbs<n / 2 + 1> r = {};
+	size_t i = 0;
+	ull radix = 10;
+	if (n > 2 && s[0] == '0' && (s[1] == 'x' || s[1] == 'X')) {
+		radix = 16;
+		i = 2;
+	}
+	else if (n > 2 && s[0] == '0' && (s[1] == 'b' || s[1] == 'B')) {
+		radix = 2;
+		i = 2;
+	}
+	else if (n > 1 && s[0] == '0')
+		radix = 8;
+
+	r.size = 1;
+	for (; i < n; ++i) {
+		if (s[i] == '\'')
+			continue;
+		ull c = long_literal_digit(s[i]);
+		if (c >= radix)
+			throw "invalid digit in a Long literal"; // a compile error, the call is constant
+		for (uint k = 0; k < r.size; ++k) {
+			c += r.limb[k] * radix;
+			r.limb[k] = c % Long::base;
+			c /= Long::base;
+		}
+		if (c != 0)
+			r.limb[r.size++] = c;
+	}
+	return r;
+}
+
+template <char... D>
+Long operator""_L()
+{
+	static constexpr auto v = long_literal_limbs<D...>();
+	return Long::from_limbs(v.limb, v.size);
+}
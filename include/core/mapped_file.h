@@ -0,0 +1,115 @@
+#pragma once
+#include "core/serialize.h"
+#include <memory>
+#include <string>
+
+// Read-only views of serialized records (see serialize.h) in a file mapped
+// into memory. Nothing is read up front: the system pages the limbs or
+// elements in as they are used and can drop them again, so a job starts at
+// once and its inputs may be larger than the memory at hand. Opening checks
+// the header and the file length only; the limbs are trusted, checking them
+// would touch every page. Little endian hosts only, where the records are
+// laid out as in memory.
+//
+//     LongView x("x.bin"), y("y.bin");
+//     Long z = x * y;                      // transforms read the mapped limbs
+//     MatrixView<double> a("a.bin");
+//     Matrix<double> c = a.multiply(b);    // any algorithm, no copy of a
+
+// The whole file, mapped read-only until destroyed; views share one
+class MappedFile
+{
+	const unsigned char* data_;
+	size_t size_;
+#ifdef _WIN32
+	void* file_;
+	void* mapping_;
+#endif
+	void release();
+
+public:
+	explicit MappedFile(const std::string& filename);
+	~MappedFile();
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+
+	const unsigned char* data() const { return data_; }
+	size_t size() const { return size_; }
+};
+
+// Limbs of a number held elsewhere: in a mapped Long record, or in a Long
+// or array that must outlive the view
+class LongView
+{
+	std::shared_ptr<const MappedFile> file_;
+	const ull* limbs_;
+	uint size_;
+	bool negative_;
+
+public:
+	explicit LongView(const std::string& filename);
+	explicit LongView(const char* filename) : LongView(std::string(filename)) {} // not the Long of a digit string
+	LongView(const ull* limbs, uint n, bool negative = false); // normalized base limbs, lowest first
+	LongView(const Long& x);
+
+	uint size() const { return size_; }
+	bool negative() const { return negative_; }
+	const ull* limbs() const { return limbs_; }
+	ull operator[](uint i) const { return limbs_[i]; }
+	bool is_zero() const { return size_ == 1 && limbs_[0] == 0; }
+
+	int compare(const LongView& other) const; // -1, 0, 1 by value
+	ull mod_small(ull d) const;               // |this| mod d, as Long::mod_small
+	Long to_long() const;                     // a copy
+};
+
+// From 100 limbs up (where Long switches to the NTT) the product is transformed straight from the
+// viewed limbs; smaller ones go through Long.
+Long operator*(const LongView& x, const LongView& y);
+bool operator==(const LongView& x, const LongView& y);
+bool operator<(const LongView& x, const LongView& y);
+
+// A mapped Matrix record, seen by everything as a const Matrix<T> whose
+// elements are borrowed from the mapping; copies of that matrix own theirs.
+template<typename T = double>
+class MatrixView
+{
+	std::shared_ptr<const MappedFile> file_;
+	Matrix<T> matrix_;
+
+	static Matrix<T> borrow(const MappedFile& file)
+	{
+		static_assert(serial::host_little_endian, "MatrixView: the records are little endian");
+		serial::Header h = serial::get_header(file.data(), file.size(), serial::MATRIX);
+		serial::check_matrix<T>(h);
+		serial::check_payload(file.size() - serial::header_size, h.n * h.m, sizeof(T));
+		return Matrix<T>(typename Matrix<T>::Borrow(), h.n, h.m, reinterpret_cast<const T*>(file.data() + serial::header_size));
+	}
+
+public:
+	using AlgorithmType = typename Matrix<T>::MatrixMultiplicationAlgorithm::AlgorithmType;
+
+	explicit MatrixView(const std::string& filename)
+		: file_(std::make_shared<const MappedFile>(filename)), matrix_(borrow(*file_)) {}
+	MatrixView(const MatrixView& other)
+		: file_(other.file_), matrix_(typename Matrix<T>::Borrow(), other.rows(), other.cols(), other.data()) {}
+	MatrixView(MatrixView&& other) noexcept = default;
+	MatrixView& operator=(MatrixView other) noexcept
+	{
+		std::swap(file_, other.file_);
+		std::swap(matrix_, other.matrix_);
+		return *this;
+	}
+
+	size_type rows() const { return matrix_.rows(); }
+	size_type cols() const { return matrix_.cols(); }
+	const T& operator()(size_type row, size_type col) const { return matrix_(row, col); }
+	const T* data() const { return matrix_.data(); }
+
+	const Matrix<T>& matrix() const { return matrix_; }
+	operator const Matrix<T>&() const { return matrix_; }
+	Matrix<T> multiply(const Matrix<T>& other, AlgorithmType algo = AlgorithmType::AUTO) const
+	{
+		return matrix_.multiply(other, algo);
+	}
+};
@@ -19,4 +19,9 @@ Long pow(const Long & a, const Long & n);
 // Greatest common divisor
 Long gcd(const Long& u, const Long& v);
 
+// Product / remainder trees
+vector<vector<Long>> product_tree(const vector<Long>& x);
+vector<Long> multi_mod(const Long& x, const vector<Long>& moduli);
+vector<Long> batch_gcd(const vector<Long>& x);
+
 #endif // MATH_H 
\ No newline at end of file
@@ -13,10 +13,16 @@
 #include <fstream>
 #include <sstream>
 #include <stdexcept>
+#include <charconv>
+#include <thread>
+#include <exception>
+#include "core/task_scheduler.h"
 
 // Type definitions for matrix operations
 using size_type = std::size_t;
 
+template<typename T> class MatrixView;
+
 template<typename T = double>
 class Matrix {
 public:
@@ -60,6 +66,9 @@ public:
         public:
         static Matrix construct_result(const Matrix& matrix, const Matrix& other);
         static void validate_dimensions(const Matrix& matrix, const Matrix& other);
+        // f(first, last) on panels of the rows of the product, in parallel
+        template<typename F>
+        static void for_row_panels(const Matrix& matrix, const Matrix& other, F f);
         
         // MatrixMultiplicationAlgorithm types for matrix multiplication
         enum class AlgorithmType {
@@ -70,6 +79,7 @@ public:
             STRASSEN,
             WINOGRAD,
             ALPHA_TENSOR,
+            BLOCKED_GEMM,
             AUTO 
         };
 
@@ -94,8 +104,8 @@ public:
         static Matrix multiply_fallback(const Matrix& matrix, const Matrix& other);
         
         private:
-        static void simd_multiply_aligned(const Matrix& A, const Matrix& B, Matrix& C);
-        static void simd_multiply_unaligned(const Matrix& A, const Matrix& B, Matrix& C);
+        static void simd_multiply_aligned(const Matrix& A, const Matrix& B_transposed, Matrix& C, size_type first, size_type last);
+        static void simd_multiply_unaligned(const Matrix& A, const Matrix& B_transposed, Matrix& C, size_type first, size_type last);
     };
 
     class ArmNeonMatrixMultiplicationAlgorithm {
@@ -106,8 +116,21 @@ public:
         static Matrix multiply_fallback(const Matrix& matrix, const Matrix& other);
         
         private:
-        static void neon_multiply_aligned(const Matrix& A, const Matrix& B, Matrix& C);
-        static void neon_multiply_unaligned(const Matrix& A, const Matrix& B, Matrix& C);
+        static void neon_multiply_aligned(const Matrix& A, const Matrix& B_transposed, Matrix& C, size_type first, size_type last);
+        static void neon_multiply_unaligned(const Matrix& A, const Matrix& B_transposed, Matrix& C, size_type first, size_type last);
+    };
+
+    // BLIS-style GEMM: panels of B and blocks of A packed to stay in L3 and L2,
+    // an MR x NR register tile of FMAs in the micro-kernel (8 x 24 with AVX-512,
+    // 6 x 8 with AVX2, plain loops otherwise); see GemmTile for the sizes
+    class BlockedGemmMatrixMultiplicationAlgorithm {
+        public:
+        static Matrix multiply(const Matrix& matrix, const Matrix& other);
+
+        private:
+        static void pack_a(const Matrix& A, size_type row, size_type col, size_type mc, size_type kc, value_type* to);
+        static void pack_b(const Matrix& B, size_type row, size_type col, size_type kc, size_type nc, value_type* to);
+        static void micro_kernel(size_type kc, const value_type* a, const value_type* b, value_type* c, size_type ldc);
     };
 
     // Superbase class for block-based matrix multiplication algorithms using CRTP
@@ -125,6 +148,9 @@ public:
         }
         
         protected:
+        // sub-products of smaller blocks run on the calling thread
+        static constexpr size_type parallel_block_size = 64;
+
         static Matrix split_and_multiply(const Matrix& matrix, const Matrix& other);
 
         static Matrix* compute_from_blocks(const Matrix* A_blocks, const Matrix* B_blocks){
@@ -229,7 +255,7 @@ public:
     // Data access (for advanced users)
     value_type* data();
     const value_type* data() const;
-    const std::vector<value_type>& get_data() const;
+    const std::vector<value_type>& get_data() const; // throws for a matrix borrowed by a MatrixView
     
     // Verification
     bool is_equal(const Matrix& other, value_type tolerance = 1e-10) const;
@@ -237,7 +263,14 @@ public:
 private:
     size_type rows_;
     size_type cols_;
-    std::vector<value_type> data_;
+    std::vector<value_type> storage_;
+    value_type* data_; // storage_.data(), or elements a MatrixView maps read-only
+
+    // Borrows rows * cols elements at data; a copy owns its elements again
+    friend class MatrixView<T>;
+    struct Borrow {};
+    Matrix(Borrow, size_type rows, size_type cols, const value_type* data);
+    size_type count() const { return rows_ * cols_; }
     
     // Helper methods
     size_type index(size_type row, size_type col) const;
@@ -283,6 +316,7 @@ Matrix<T> create_random_normal(size_type rows, size_type cols,
 #include "../../src/core/matrix_multiplication_algorithms/winograd_matrix_multiplication_algorithm.cpp"
 #include "../../src/core/matrix_multiplication_algorithms/auto_matrix_multiplication_algorithm.cpp"
 #include "../../src/core/matrix_multiplication_algorithms/alpha_tensor_matrix_multiplication_algorithm.cpp"
+#include "../../src/core/matrix_multiplication_algorithms/blocked_gemm_matrix_multiplication_algorithm.cpp"
 #include "../../src/core/matrix_utils.cpp"
 
 #endif // MATRIX_H 
\ No newline at end of file
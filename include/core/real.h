@@ -4,26 +4,45 @@
 class Real : public Long{
 	static const char* delim_mant;
 	uint mantissa_place;
-	Real normalmant();
+	uint precision; // limbs a product keeps, 0 for all of them
+	Real& normalmant();
+	friend std::ostream & operator<<(std::ostream & stream, const Real& b);
 
 public:
-	Real cut(uint t = 16);
+	static constexpr uint div_limbs = 16; // limbs of a quotient or root of exact operands, at least
+
+	Real& cut(uint t = 16);
+	Real& round(uint t = 16); // to t limbs, to nearest; unlike cut the integer part stays whole
 	uint set_mant(uint mant) { mantissa_place = mant; return mantissa_place; }
 	uint get_mant() const { return mantissa_place; }
+	uint set_prec(uint limbs) { precision = limbs; return precision; }
+	uint get_prec() const { return precision; }
 	Real(const Long& value, uint m = 0); // if you want 0.1: value = 1000, m = 1
+	Real(Long&& value, uint m = 0);
 	                                          //     0.01: 2, 100
 	                                          //  0.000001: 6, 100
 	
 	Real operator+(const Real& other) const;
 	Real operator-(const Real& other) const;
 	Real operator*(const Real& other) const;
+	Real operator/(const Real& other) const;
+
+	Real& operator+=(const Real& other);
+	Real& operator-=(const Real& other);
+	Real& operator*=(const Real& other);
+	Real& operator/=(const Real& other);
 
 	Real(const Real &other);
-	Real(Real &&other);
+	Real(Real &&other) noexcept;
 	Real& operator=(const Real& other);
-	Real& operator=(Real&& other);
+	Real& operator=(Real&& other) noexcept;
 
 	operator std::string() const;
 };
 
-std::ostream & operator<<(std::ostream & stream, Real b);
\ No newline at end of file
+std::ostream & operator<<(std::ostream & stream, const Real& b);
+
+// Newton's iteration from a double, the precision doubling each step up to
+// limbs significant limbs; 0 takes the precision of x, or div_limbs if it has none
+Real rsqrt(const Real& x, uint limbs = 0); // 1 / sqrt(x)
+Real sqrt(const Real& x, uint limbs = 0);
\ No newline at end of file
@@ -0,0 +1,173 @@
+#pragma once
+#include "core/long.h"
+#include "core/real.h"
+#include "core/matrix.h"
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+// Binary records of Long, Real and Matrix, little endian whatever the host:
+//
+//     0  "LNUM"                   magic
+//     4  u16 version              serial::version
+//     6  u16 kind                 1 Long, 2 Real, 3 Matrix
+//     8  u64 n                    limbs, or rows
+//    16  u64 m                    0, mantissa_place, or cols
+//    24  u32 p                    1 if negative, or bytes per element
+//    28  u32 q                    0, precision, or 1 for floating point
+//    32  payload                  n limbs as u64, lowest first, or the
+//                                 n * m elements row by row
+//
+// The limbs are stored as Long keeps them in memory, so on a little endian
+// host both directions are one copy, and the payload of a mapped file starts
+// 8-byte aligned. Records can follow one another: deserialize from a buffer
+// returns the bytes it read. A record that is cut short, of another kind or
+// version, or with a limb not below Long::base throws std::runtime_error.
+//
+//     std::vector<unsigned char> buf;
+//     serialize(x, buf);                  // appended
+//     serialize(y, "y.bin");
+//     Long x2 = null;
+//     size_t used = deserialize(buf.data(), buf.size(), x2);
+//     Matrix<double> m;
+//     deserialize("m.bin", m);
+
+namespace serial {
+
+constexpr uint16_t version = 1;
+constexpr size_t header_size = 32;
+enum Kind : uint16_t { LONG = 1, REAL = 2, MATRIX = 3 };
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+constexpr bool host_little_endian = false;
+#else
+constexpr bool host_little_endian = true;
+#endif
+
+struct Header
+{
+	uint16_t kind;
+	uint64_t n, m;
+	uint32_t p, q;
+};
+
+void put_header(unsigned char* out, const Header& h);
+// checks the magic, version and kind, and that size holds the header
+Header get_header(const unsigned char* in, size_t size, uint16_t kind);
+
+// count elements of width bytes (1, 2, 4 or 8) between host order and little endian
+void put_le(unsigned char* out, const void* in, size_t count, size_t width);
+void get_le(void* out, const unsigned char* in, size_t count, size_t width);
+void write_le(std::ostream& out, const void* in, size_t count, size_t width);
+void read_le(std::istream& in, void* out, size_t count, size_t width);
+
+constexpr size_t chunk = 1 << 16; // bytes swapped, or read off a stream, at a time
+
+// count values off a stream, the vector growing a chunk at a time: a corrupt
+// count runs into the end of the stream instead of allocating its full size
+template<typename T>
+std::vector<T> read_le_vector(std::istream& in, uint64_t count)
+{
+	std::vector<T> v;
+	while (v.size() < count) {
+		size_t at = v.size(), k = (size_t)std::min<uint64_t>(count - at, chunk / sizeof(T));
+		v.resize(at + k);
+		read_le(in, v.data() + at, k, sizeof(T));
+	}
+	return v;
+}
+
+void write_header(std::ostream& out, const Header& h);
+Header read_header(std::istream& in, uint16_t kind);
+std::ofstream open_out(const std::string& filename);
+std::ifstream open_in(const std::string& filename);
+void check_payload(size_t available, uint64_t count, size_t width);
+
+template<typename T>
+Header matrix_header(size_type rows, size_type cols)
+{
+	static_assert(std::is_arithmetic<T>::value, "serialize: Matrix elements must be arithmetic");
+	return { MATRIX, rows, cols, (uint32_t)sizeof(T), std::is_floating_point<T>::value ? 1u : 0u };
+}
+
+template<typename T>
+void check_matrix(const Header& h)
+{
+	Header t = matrix_header<T>(0, 0);
+	if (h.p != t.p || h.q != t.q)
+		throw std::runtime_error("deserialize: matrix elements of another type");
+	if (h.m != 0 && h.n > SIZE_MAX / sizeof(T) / h.m)
+		throw std::runtime_error("deserialize: matrix too large");
+}
+
+} // namespace serial
+
+void serialize(const Long& x, std::vector<unsigned char>& out);
+void serialize(const Long& x, std::ostream& out);
+void serialize(const Long& x, const std::string& filename);
+size_t deserialize(const unsigned char* data, size_t size, Long& x);
+void deserialize(std::istream& in, Long& x);
+void deserialize(const std::string& filename, Long& x);
+
+void serialize(const Real& x, std::vector<unsigned char>& out);
+void serialize(const Real& x, std::ostream& out);
+void serialize(const Real& x, const std::string& filename);
+size_t deserialize(const unsigned char* data, size_t size, Real& x);
+void deserialize(std::istream& in, Real& x);
+void deserialize(const std::string& filename, Real& x);
+
+template<typename T>
+void serialize(const Matrix<T>& x, std::vector<unsigned char>& out)
+{
+	size_t at = out.size(), count = x.rows() * x.cols();
+	out.resize(at + serial::header_size + count * sizeof(T));
+	serial::put_header(out.data() + at, serial::matrix_header<T>(x.rows(), x.cols()));
+	serial::put_le(out.data() + at + serial::header_size, x.data(), count, sizeof(T));
+}
+
+template<typename T>
+void serialize(const Matrix<T>& x, std::ostream& out)
+{
+	serial::write_header(out, serial::matrix_header<T>(x.rows(), x.cols()));
+	serial::write_le(out, x.data(), x.rows() * x.cols(), sizeof(T));
+}
+
+template<typename T>
+void serialize(const Matrix<T>& x, const std::string& filename)
+{
+	std::ofstream file = serial::open_out(filename);
+	serialize(x, file);
+}
+
+template<typename T>
+size_t deserialize(const unsigned char* data, size_t size, Matrix<T>& x)
+{
+	serial::Header h = serial::get_header(data, size, serial::MATRIX);
+	serial::check_matrix<T>(h);
+	serial::check_payload(size - serial::header_size, h.n * h.m, sizeof(T));
+	Matrix<T> r(h.n, h.m);
+	serial::get_le(r.data(), data + serial::header_size, h.n * h.m, sizeof(T));
+	x = std::move(r);
+	return serial::header_size + h.n * h.m * sizeof(T);
+}
+
+template<typename T>
+void deserialize(std::istream& in, Matrix<T>& x)
+{
+	serial::Header h = serial::read_header(in, serial::MATRIX);
+	serial::check_matrix<T>(h);
+	std::vector<T> v = serial::read_le_vector<T>(in, h.n * h.m);
+	Matrix<T> r(h.n, h.m);
+	std::memcpy(r.data(), v.data(), v.size() * sizeof(T));
+	x = std::move(r);
+}
+
+template<typename T>
+void deserialize(const std::string& filename, Matrix<T>& x)
+{
+	std::ifstream file = serial::open_in(filename);
+	deserialize(file, x);
+}
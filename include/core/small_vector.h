@@ -0,0 +1,285 @@
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+#include <new>
+#include <vector>
+#include <iterator>
+#include <algorithm>
+#include <utility>
+#include <type_traits>
+#include <stdexcept>
+
+// Plain operator new / delete; see limb_alloc.h for the one Long uses.
+struct SmallVectorHeap
+{
+	static void* allocate(size_t bytes) { return ::operator new(bytes); }
+	static void deallocate(void* p, size_t) { ::operator delete(p); }
+};
+
+// Vector with the first N elements stored inside the object; the heap is
+// touched only when the size grows beyond N. Implements the subset of the
+// std::vector interface Long uses for its limbs. T must be trivially
+// copyable: elements are moved with memcpy/memmove.
+//
+// The elements need not start at the beginning of their block: inserting
+// at the front takes free slots before ptr when there are any, erasing at
+// the front just moves ptr. A front insertion that does not fit reserves
+// as much room again in front, so repeated shifts by whole limbs cost
+// O(1) amortized instead of a memmove of the whole number each.
+template <class T, unsigned N, class Alloc = SmallVectorHeap>
+class SmallVector
+{
+	static_assert(std::is_trivially_copyable<T>::value, "SmallVector: T must be trivially copyable");
+	static_assert(N > 0, "SmallVector: inline capacity must be positive");
+
+	T* ptr;
+	unsigned sz;
+	unsigned cap;  // slots from ptr to the end of the block
+	unsigned head; // free slots in front of ptr
+	T buf[N];
+
+	bool is_inline() const { return ptr - head == buf; }
+
+	static T* allocate(unsigned n) { return static_cast<T*>(Alloc::allocate(sizeof(T) * n)); }
+	void release() { if (!is_inline()) Alloc::deallocate(ptr - head, sizeof(T) * (head + cap)); }
+
+	// moves the elements to a new block with h free slots in front and c from ptr on
+	void relocate(unsigned h, unsigned c, unsigned gap = 0)
+	{
+		T* p = allocate(h + c) + h;
+		if (sz)
+			std::memcpy(p + gap, ptr, sizeof(T) * sz);
+		release();
+		ptr = p;
+		head = h;
+		cap = c;
+	}
+
+	void grow(unsigned n)
+	{
+		if (n <= cap)
+			return;
+		unsigned c = cap * 2;
+		if (c < n)
+			c = n;
+		relocate(head, c);
+	}
+
+	template <class It>
+	bool aliases(It) const { return false; }
+	bool aliases(const T* p) const { return p >= ptr && p < ptr + sz; }
+	bool aliases(T* p) const { return p >= ptr && p < ptr + sz; }
+
+	// opens a gap of n elements at position i
+	T* open(unsigned i, unsigned n)
+	{
+		if (i > sz)
+			throw std::out_of_range("SmallVector: position out of range");
+		if (i == 0 && n > 0) {
+			if (n > head && is_inline() && sz + n <= N) {
+				// small: slide to the start of the buffer as a plain vector would
+				std::memmove(buf + n, ptr, sizeof(T) * sz);
+				ptr = buf;
+				cap = N;
+				head = 0;
+			}
+			else if (n > head)
+				relocate(sz + n, cap + n, n);
+			else {
+				ptr -= n;
+				head -= n;
+				cap += n;
+			}
+			sz += n;
+			return ptr;
+		}
+		grow(sz + n);
+		if (i < sz)
+			std::memmove(ptr + i + n, ptr + i, sizeof(T) * (sz - i));
+		sz += n;
+		return ptr + i;
+	}
+
+public:
+	typedef T value_type;
+	typedef T* iterator;
+	typedef const T* const_iterator;
+	typedef unsigned size_type;
+
+	SmallVector() : ptr(buf), sz(0), cap(N), head(0) {}
+	SmallVector(size_type n, const T& v = T()) : SmallVector() { resize(n, v); }
+	template <class It, class = typename std::iterator_traits<It>::iterator_category>
+	SmallVector(It first, It last) : SmallVector() { insert(end(), first, last); }
+	explicit SmallVector(const std::vector<T>& v) : SmallVector(v.cbegin(), v.cend()) {}
+
+	SmallVector(const SmallVector& other) : SmallVector() { *this = other; }
+	SmallVector(SmallVector&& other) noexcept : SmallVector() { *this = std::move(other); }
+
+	SmallVector& operator=(const SmallVector& other)
+	{
+		if (this != &other) {
+			sz = 0;
+			grow(other.sz);
+			if (other.sz)
+				std::memcpy(ptr, other.ptr, sizeof(T) * other.sz);
+			sz = other.sz;
+		}
+		return *this;
+	}
+
+	// heap buffers are stolen, inline ones copied
+	SmallVector& operator=(SmallVector&& other) noexcept
+	{
+		if (this == &other)
+			return *this;
+		if (other.is_inline()) {
+			clear();
+			grow(other.sz);
+			if (other.sz)
+				std::memcpy(ptr, other.ptr, sizeof(T) * other.sz);
+			sz = other.sz;
+		}
+		else {
+			release();
+			ptr = other.ptr;
+			sz = other.sz;
+			cap = other.cap;
+			head = other.head;
+			other.ptr = other.buf;
+			other.cap = N;
+			other.head = 0;
+		}
+		other.sz = 0;
+		return *this;
+	}
+
+	~SmallVector()
+	{
+		release();
+	}
+
+	size_type size() const { return sz; }
+	size_type capacity() const { return cap; }
+	bool empty() const { return sz == 0; }
+	static constexpr size_type inline_capacity() { return N; }
+
+	T* data() { return ptr; }
+	const T* data() const { return ptr; }
+	T& operator[](size_type i) { return ptr[i]; }
+	const T& operator[](size_type i) const { return ptr[i]; }
+	T& front() { return ptr[0]; }
+	const T& front() const { return ptr[0]; }
+	T& back() { return ptr[sz - 1]; }
+	const T& back() const { return ptr[sz - 1]; }
+
+	iterator begin() { return ptr; }
+	iterator end() { return ptr + sz; }
+	const_iterator begin() const { return ptr; }
+	const_iterator end() const { return ptr + sz; }
+	const_iterator cbegin() const { return ptr; }
+	const_iterator cend() const { return ptr + sz; }
+
+	void reserve(size_type n) { grow(n); }
+	// also gives the front slots back to the end
+	void clear()
+	{
+		sz = 0;
+		ptr -= head;
+		cap += head;
+		head = 0;
+	}
+
+	// drops the heap buffer if the contents fit inline again
+	void shrink_to_fit()
+	{
+		if (is_inline() || sz > N)
+			return;
+		std::memcpy(buf, ptr, sizeof(T) * sz);
+		release();
+		ptr = buf;
+		cap = N;
+		head = 0;
+	}
+
+	void resize(size_type n, const T& v = T())
+	{
+		grow(n);
+		for (size_type i = sz; i < n; ++i)
+			ptr[i] = v;
+		sz = n;
+	}
+
+	void push_back(const T& v)
+	{
+		if (sz == cap) {
+			T t = v; // v may live in the buffer being reallocated
+			grow(sz + 1);
+			ptr[sz++] = t;
+		}
+		else
+			ptr[sz++] = v;
+	}
+	void emplace_back(const T& v) { push_back(v); }
+	void pop_back() { --sz; }
+
+	iterator insert(const_iterator pos, const T& v) { return insert(pos, 1, v); }
+	iterator emplace(const_iterator pos, const T& v) { return insert(pos, 1, v); }
+
+	iterator insert(const_iterator pos, size_type n, const T& v)
+	{
+		T t = v;
+		T* p = open((unsigned)(pos - ptr), n);
+		for (size_type i = 0; i < n; ++i)
+			p[i] = t;
+		return p;
+	}
+
+	template <class It, class = typename std::iterator_traits<It>::iterator_category>
+	iterator insert(const_iterator pos, It first, It last)
+	{
+		auto n = (unsigned)std::distance(first, last);
+		unsigned i = (unsigned)(pos - ptr);
+		if (n == 0)
+			return ptr + i;
+		if (aliases(first)) {
+			std::vector<T> tmp(first, last);
+			return insert(pos, tmp.cbegin(), tmp.cend());
+		}
+		T* p = open(i, n);
+		std::copy(first, last, p);
+		return p;
+	}
+
+	iterator erase(const_iterator first, const_iterator last)
+	{
+		unsigned i = (unsigned)(first - ptr), j = (unsigned)(last - ptr);
+		if (i == 0) {
+			ptr += j;
+			head += j;
+			cap -= j;
+			sz -= j;
+			return ptr;
+		}
+		if (j < sz)
+			std::memmove(ptr + i, ptr + j, sizeof(T) * (sz - j));
+		sz -= j - i;
+		return ptr + i;
+	}
+	iterator erase(const_iterator pos) { return erase(pos, pos + 1); }
+
+	void swap(SmallVector& other)
+	{
+		SmallVector t = std::move(other);
+		other = std::move(*this);
+		*this = std::move(t);
+	}
+
+	std::vector<T> to_vector() const { return std::vector<T>(cbegin(), cend()); }
+
+	bool operator==(const SmallVector& other) const
+	{
+		return sz == other.sz && (sz == 0 || std::memcmp(ptr, other.ptr, sizeof(T) * sz) == 0);
+	}
+	bool operator!=(const SmallVector& other) const { return !(*this == other); }
+};
@@ -0,0 +1,229 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// One pool of worker threads shared by every parallel algorithm, so that
+// nested work (the seven Strassen sub-products, each splitting again) fills
+// the cores once instead of starting threads of its own. Tasks are spawned
+// into a TaskGroup and joined by wait(); a waiting thread runs queued tasks
+// in the meantime, so nesting cannot deadlock. A group more than
+// max_depth() levels down runs its tasks at once on the calling thread: the
+// depth cutoff that keeps the recursion from flooding the queue.
+//
+//     TaskGroup g;
+//     g.run([&] { left = a.multiply(b); });
+//     right = c.multiply(d);
+//     g.wait();
+//
+//     parallel_for(0, rows, 16, [&](size_t begin, size_t end) { ... });
+class TaskScheduler {
+public:
+    static TaskScheduler& instance() {
+        static TaskScheduler scheduler;
+        return scheduler;
+    }
+
+    // workers plus the calling thread
+    unsigned threads() const { return (unsigned)workers_.size() + 1; }
+    // 0 for std::thread::hardware_concurrency(), 1 for no workers at all; only while no task runs
+    void set_threads(unsigned n) {
+        stop();
+        start((n ? n : default_threads()) - 1);
+    }
+    unsigned max_depth() const { return max_depth_; }
+    void set_max_depth(unsigned depth) { max_depth_ = depth; }
+
+    // nesting depth of the task running on this thread, 0 outside any
+    static unsigned& depth() {
+        thread_local unsigned d = 0;
+        return d;
+    }
+
+    void submit(std::function<void()> task) {
+        {
+            std::lock_guard<std::mutex> guard(lock_);
+            queue_.push_back(std::move(task));
+        }
+        ready_.notify_one();
+        idle_.notify_one();
+    }
+
+    // one queued task on this thread; false if there was none
+    bool run_one() {
+        std::function<void()> task;
+        {
+            std::lock_guard<std::mutex> guard(lock_);
+            if (queue_.empty()) {
+                return false;
+            }
+            task = std::move(queue_.back()); // the newest: most likely the caller's own subtask
+            queue_.pop_back();
+        }
+        task();
+        return true;
+    }
+
+    // Counts a task of a group as done. The count drops under the lock, so a
+    // waiter cannot miss it between its check and its sleep; the group may
+    // be gone as soon as it is down, and only the scheduler is touched after.
+    void finish(std::atomic<size_t>& pending) {
+        {
+            std::lock_guard<std::mutex> guard(lock_);
+            --pending;
+        }
+        idle_.notify_all();
+    }
+
+    // Until pending is down to 0: runs queued tasks while there are any,
+    // sleeps while there are none and the rest are still running elsewhere.
+    void wait_for(const std::atomic<size_t>& pending) {
+        while (pending > 0) {
+            if (run_one()) {
+                continue;
+            }
+            std::unique_lock<std::mutex> guard(lock_);
+            idle_.wait(guard, [&] { return pending == 0 || !queue_.empty(); });
+        }
+    }
+
+private:
+    std::mutex lock_;
+    std::condition_variable ready_;
+    std::condition_variable idle_; // for wait_for: a task queued or a task done
+    std::deque<std::function<void()>> queue_;
+    std::vector<std::thread> workers_;
+    bool stopping_ = false;
+    unsigned max_depth_ = 3;
+
+    TaskScheduler() { start(default_threads() - 1); }
+    ~TaskScheduler() { stop(); }
+
+    static unsigned default_threads() { return std::max(1u, std::thread::hardware_concurrency()); }
+
+    void start(unsigned workers) {
+        for (unsigned i = 0; i < workers; ++i) {
+            workers_.emplace_back([this] { work(); });
+        }
+    }
+
+    // the queue is drained before the workers leave
+    void stop() {
+        {
+            std::lock_guard<std::mutex> guard(lock_);
+            stopping_ = true;
+        }
+        ready_.notify_all();
+        for (auto& t : workers_) {
+            t.join();
+        }
+        workers_.clear();
+        stopping_ = false;
+    }
+
+    void work() {
+        for (;;) {
+            std::function<void()> task;
+            {
+                std::unique_lock<std::mutex> guard(lock_);
+                ready_.wait(guard, [this] { return stopping_ || !queue_.empty(); });
+                if (queue_.empty()) {
+                    return;
+                }
+                task = std::move(queue_.front()); // the oldest: the biggest pieces of work
+                queue_.pop_front();
+            }
+            task();
+        }
+    }
+};
+
+// Tasks joined together; the first exception one of them throws comes out
+// of wait(). Without workers, past the depth cutoff, or when asked for a
+// serial group, run() just calls.
+class TaskGroup {
+public:
+    // parallel = false: a group that runs everything on the calling thread
+    explicit TaskGroup(bool parallel = true)
+        : serial_(!parallel || TaskScheduler::instance().threads() == 1 ||
+                  TaskScheduler::depth() >= TaskScheduler::instance().max_depth()) {}
+    TaskGroup(const TaskGroup&) = delete;
+    TaskGroup& operator=(const TaskGroup&) = delete;
+    ~TaskGroup() {
+        try {
+            wait();
+        } catch (...) {
+        }
+    }
+
+    bool serial() const { return serial_; }
+
+    template<typename F>
+    void run(F f) {
+        if (serial_) {
+            f();
+            return;
+        }
+        ++pending_;
+        unsigned depth = TaskScheduler::depth() + 1;
+        TaskScheduler::instance().submit([this, f = std::move(f), depth]() mutable {
+            unsigned outer = TaskScheduler::depth();
+            TaskScheduler::depth() = depth;
+            try {
+                f();
+            } catch (...) {
+                std::lock_guard<std::mutex> guard(lock_);
+                if (!error_) {
+                    error_ = std::current_exception();
+                }
+            }
+            TaskScheduler::depth() = outer;
+            TaskScheduler::instance().finish(pending_); // the group may be gone right after this
+        });
+    }
+
+    void wait() {
+        TaskScheduler::instance().wait_for(pending_);
+        if (error_) {
+            std::exception_ptr e = error_;
+            error_ = nullptr;
+            std::rethrow_exception(e);
+        }
+    }
+
+private:
+    const bool serial_;
+    std::atomic<size_t> pending_{0};
+    std::mutex lock_;
+    std::exception_ptr error_;
+};
+
+// f(b, e) over [begin, end) cut into at most threads() pieces of at least
+// grain each, the calling thread taking the first
+template<typename F>
+void parallel_for(size_t begin, size_t end, size_t grain, F f) {
+    if (end <= begin) {
+        return;
+    }
+    size_t n = end - begin;
+    size_t pieces = std::min<size_t>(TaskScheduler::instance().threads(), (n + grain - 1) / std::max<size_t>(grain, 1));
+    TaskGroup group;
+    if (pieces <= 1 || group.serial()) {
+        f(begin, end);
+        return;
+    }
+    size_t step = (n + pieces - 1) / pieces;
+    for (size_t b = begin + step; b < end; b += step) {
+        size_t e = std::min(end, b + step);
+        group.run([&f, b, e] { f(b, e); });
+    }
+    f(begin, std::min(end, begin + step));
+    group.wait();
+}
@@ -19,7 +19,7 @@ struct Rab_MilTest : PrimeTest {
 };
 
 // Jacobi symbol calculation
-Long Jacobi(Long& a, Long& n);
+int Jacobi(const Long& a, const Long& n);
 
 // General prime testing function
 double prtest_general(const Long & p, ull iter, double (*_met)(Long& a, const Long& p));
@@ -1,7 +1,17 @@
 #include "core/matrix.h"
+#include "core/limb_alloc.h"
+#include "core/limb_kernels.h"
+#include "core/long_accum.h"
+#include "core/fixed_long.h"
+#include "core/bigfloat.h"
+#include "core/constants.h"
+#include "core/elementary.h"
+#include "core/mapped_file.h"
+#include "prime/prime_test.h"
 #include <iostream>
 #include <chrono>
 #include <iomanip>
+#include <cstdio>
 #include <vector>
 #include <algorithm>
 #include <numeric>
@@ -19,6 +29,15 @@ double measure_time(Func func) {
     return duration.count() / 1e6; // Convert to milliseconds
 }
 
+// limbs random base limbs, the top one base - 1 so that none is lost
+Long random_long(std::mt19937_64& gen, uint limbs, bool negative = false) {
+    std::vector<ull> v(limbs);
+    for (auto& x : v)
+        x = gen() % Long::base;
+    v.back() = Long::base - 1;
+    return Long::from_limbs(v.data(), limbs, negative);
+}
+
 // Statistics calculation
 struct PerformanceStats {
     double min_time;
@@ -167,10 +186,540 @@ void compare_algorithms(const std::vector<std::pair<std::string, PerformanceStat
     std::cout << "Baseline (Naive): " << naive_time << " ms" << std::endl;
 }
 
+// Per-limb throughput of the Long limb kernels for every ISA the CPU supports
+void benchmark_limb_kernels(size_t limbs = 4096, int repeats = 2000) {
+    const std::string active = limb_kernels_isa();
+    std::cout << "\n--- Limb Kernels (" << limbs << " limbs, dispatched: " << active << ") ---" << std::endl;
+
+    std::mt19937_64 gen(42);
+    std::vector<ull> x(limbs), y(limbs), r(limbs);
+    for (size_t i = 0; i < limbs; ++i) {
+        x[i] = gen() % limb_base;
+        y[i] = gen() % limb_base;
+    }
+    // equal down to the lowest limb, so compare scans the whole array
+    std::vector<ull> z = x;
+    z[0] = (x[0] + 1) % limb_base;
+
+    std::cout << std::setw(10) << "ISA"
+              << std::setw(12) << "add"
+              << std::setw(12) << "sub"
+              << std::setw(12) << "mul_small"
+              << std::setw(12) << "compare" << "   (ns/limb)" << std::endl;
+
+    volatile ull sink = 0;
+    auto per_limb = [&](auto kernel) {
+        double ms = measure_time([&] {
+            for (int k = 0; k < repeats; ++k)
+                sink = sink + kernel();
+        });
+        return ms * 1e6 / (static_cast<double>(repeats) * limbs);
+    };
+
+    for (const char* isa : { "scalar", "neon", "avx2", "avx512" }) {
+        if (!limb_kernels_use(isa))
+            continue;
+        std::cout << std::setw(10) << isa << std::fixed << std::setprecision(3)
+                  << std::setw(12) << per_limb([&] { return limbs_add(r.data(), x.data(), y.data(), limbs); })
+                  << std::setw(12) << per_limb([&] { return limbs_sub(r.data(), x.data(), y.data(), limbs); })
+                  << std::setw(12) << per_limb([&] { return limbs_mul_small(r.data(), x.data(), limbs, 9973); })
+                  << std::setw(12) << per_limb([&] { return (ull)limbs_cmp(x.data(), z.data(), limbs); })
+                  << std::defaultfloat << std::endl;
+    }
+    limb_kernels_use(active.c_str());
+
+    // one-word division is scalar on every ISA: reciprocal instead of div
+    const LimbDivisor d(9973);
+    std::cout << "div_small: " << std::fixed << std::setprecision(3)
+              << per_limb([&] { return limbs_div_small(r.data(), x.data(), limbs, d); })
+              << "   mod_small: "
+              << per_limb([&] { return limbs_mod_small(x.data(), limbs, 9973); })
+              << " (ns/limb)" << std::defaultfloat << std::endl;
+}
+
+// Modular exponentiation with a full-size exponent: Long vs FixedLong<Bits>
+template <unsigned Bits>
+void benchmark_fixed_pow_mod(int repeats = 20) {
+    std::mt19937_64 gen(Bits);
+    FixedLong<Bits> n, a, e;
+    for (unsigned i = 0; i < FixedLong<Bits>::words; ++i) {
+        n[i] = gen();
+        a[i] = gen();
+        e[i] = gen();
+    }
+    n[0] |= 1;
+    a = a % n;
+    const Long ln = n.to_long(), la = a.to_long(), le = e.to_long();
+
+    Long r_long = null;
+    FixedLong<Bits> r_fixed;
+    double long_ms = measure_time([&] { r_long = pow_mod(la, le, ln); });
+    double fixed_ms = measure_time([&] {
+        for (int k = 0; k < repeats; ++k)
+            r_fixed = pow_mod(a, e, n);
+    }) / repeats;
+
+    std::cout << std::setw(10) << Bits << std::fixed << std::setprecision(3)
+              << std::setw(14) << long_ms
+              << std::setw(14) << fixed_ms
+              << std::setw(11) << std::setprecision(1) << long_ms / fixed_ms << "x"
+              << (r_long == r_fixed.to_long() ? "" : "   MISMATCH")
+              << std::defaultfloat << std::endl;
+}
+
+void benchmark_fixed_long() {
+    std::cout << "\n--- pow_mod: Long vs FixedLong (Montgomery) ---" << std::endl;
+    std::cout << std::setw(10) << "bits"
+              << std::setw(14) << "Long (ms)"
+              << std::setw(14) << "Fixed (ms)"
+              << std::setw(12) << "speedup" << std::endl;
+    benchmark_fixed_pow_mod<256>();
+    benchmark_fixed_pow_mod<512>();
+    benchmark_fixed_pow_mod<1024>();
+}
+
+// one run of work under the heap and under the pool (warmed up by a first run)
+template <typename Work>
+void limb_alloc_rows(const char* name, uint n, Work work) {
+    const Long want = work();
+    for (LimbAllocator* alloc : {&heap_limb_allocator(), &pool_limb_allocator()}) {
+        LimbAllocator* prev = set_limb_allocator(alloc);
+        Long r = null;
+        reset_limb_alloc_stats();
+        double ms = measure_time([&] { r = work(); });
+        LimbAllocStats st = limb_alloc_stats();
+        set_limb_allocator(prev);
+
+        std::cout << std::setw(10) << name
+                  << std::setw(8) << n
+                  << std::setw(8) << (alloc == &heap_limb_allocator() ? "heap" : "pool")
+                  << std::setw(14) << st.allocations
+                  << std::setw(12) << st.system
+                  << std::setw(12) << std::fixed << std::setprecision(1) << st.bytes / 1e6
+                  << std::setw(12) << std::setprecision(3) << ms
+                  << (r == want ? "" : "   MISMATCH")
+                  << std::defaultfloat << std::endl;
+    }
+}
+
+// Limb buffers behind one pow_mod or prime test, from limb_alloc_stats():
+// "system" counts the ones that reached operator new. (A LongArena around it
+// would keep all of them, hundreds of MB at 50 limbs.)
+void benchmark_limb_alloc() {
+    std::cout << "\n--- Limb allocations: operator new vs pool ---" << std::endl;
+    std::cout << std::setw(10) << "work"
+              << std::setw(8) << "limbs"
+              << std::setw(8) << "alloc"
+              << std::setw(14) << "allocations"
+              << std::setw(12) << "system"
+              << std::setw(12) << "MB"
+              << std::setw(12) << "ms" << std::endl;
+    std::mt19937_64 gen(32);
+    for (uint n : {10u, 25u, 50u}) {
+        Long mod = random_long(gen, n);
+        if (iseven(mod))
+            mod -= pone;
+        const Long a = random_long(gen, n), e = random_long(gen, n);
+        limb_alloc_rows("pow_mod", n, [&] { return pow_mod(a, e, mod); });
+    }
+
+    // prtest_general on Mersenne primes, so that every round runs; once warm
+    // the pool should take next to nothing from the system
+    for (int k : {127, 521}) {
+        const Long p = pow(Long(2), Long(k)) - pone;
+        limb_alloc_rows("prtest", p.size(), [&] { return Long(prtest_general(p, 4, &PrimeTest::SolovStras_met) > 0 ? 1 : 0); });
+    }
+}
+
+void benchmark_accumulator(int terms = 1000) {
+    std::cout << "\n--- Summing " << terms << " terms: repeated += vs LongAccumulator (ms) ---" << std::endl;
+    std::cout << std::setw(10) << "limbs"
+              << std::setw(12) << "+="
+              << std::setw(12) << "accum"
+              << std::setw(14) << "shift, +="
+              << std::setw(14) << "accum shift" << std::endl;
+    std::mt19937_64 gen(33);
+    for (uint n : {10u, 100u, 1000u}) {
+        std::vector<Long> xs;
+        for (int k = 0; k < terms; ++k)
+            xs.push_back(random_long(gen, n, k % 3 == 0));
+        Long sum = null, shifted = null;
+        double plain_ms = measure_time([&] {
+            for (const Long& x : xs)
+                sum += x;
+        });
+        double accum_ms = measure_time([&] {
+            LongAccumulator a;
+            for (const Long& x : xs)
+                a += x;
+            if (a.value() != sum)
+                throw std::logic_error("LongAccumulator: wrong sum");
+        });
+        // term k shifted by k limbs, as in the leaves of the bit-burst series
+        double shift_ms = measure_time([&] {
+            for (int k = 0; k < terms; ++k) {
+                Long t = xs[k];
+                t.shift(k);
+                shifted += t;
+            }
+        });
+        double accum_shift_ms = measure_time([&] {
+            LongAccumulator a;
+            for (int k = 0; k < terms; ++k)
+                a.add(xs[k], 1, k);
+            if (a.value() != shifted)
+                throw std::logic_error("LongAccumulator: wrong shifted sum");
+        });
+        std::cout << std::setw(10) << n << std::fixed << std::setprecision(3)
+                  << std::setw(12) << plain_ms
+                  << std::setw(12) << accum_ms
+                  << std::setw(14) << shift_ms
+                  << std::setw(14) << accum_shift_ms
+                  << std::defaultfloat << std::endl;
+    }
+}
+
+void benchmark_real_short_mul() {
+    std::cout << "\n--- Real multiplication: full product vs kept limbs (ms per op) ---" << std::endl;
+    std::cout << std::setw(10) << "limbs"
+              << std::setw(14) << "full + cut"
+              << std::setw(14) << "short"
+              << std::setw(11) << "speedup" << std::endl;
+    std::mt19937_64 gen(41);
+    for (uint n : {50u, 200u, 500u}) {
+        Real x(random_long(gen, n), n * Long::bs), y(random_long(gen, n), n * Long::bs);
+        const int repeats = 20000 / n;
+
+        double full_ms = measure_time([&] {
+            for (int k = 0; k < repeats; ++k) {
+                Real t = x * y;
+                t.cut(n);
+            }
+        }) / repeats;
+        x.set_prec(n);
+        double short_ms = measure_time([&] {
+            for (int k = 0; k < repeats; ++k)
+                Real t = x * y;
+        }) / repeats;
+
+        std::cout << std::setw(10) << n << std::fixed << std::setprecision(4)
+                  << std::setw(14) << full_ms
+                  << std::setw(14) << short_ms
+                  << std::setw(10) << std::setprecision(1) << full_ms / short_ms << "x"
+                  << std::defaultfloat << std::endl;
+    }
+}
+
+void benchmark_real_add() {
+    std::cout << "\n--- Real a + b, b with 7 more fraction digits: scaled temporary vs lazy pass (ms per op) ---" << std::endl;
+    std::cout << std::setw(10) << "limbs"
+              << std::setw(14) << "temporary"
+              << std::setw(14) << "lazy"
+              << std::setw(14) << "Real +" << std::endl;
+    std::mt19937_64 gen(31);
+    for (uint n : {100u, 1000u, 10000u, 100000u}) {
+        Real a(random_long(gen, n), n * Long::bs), b(random_long(gen, n, true), n * Long::bs + 7);
+        const int repeats = std::max(3u, 200000 / n);
+
+        // a brought to b's 7 extra digits: times 10^3 and one limb of shift
+        double temp_ms = measure_time([&] {
+            for (int k = 0; k < repeats; ++k) {
+                Long t = a.mul_limb(1000);
+                t.shift(1);
+                Real r(t + b, b.get_mant());
+            }
+        }) / repeats;
+        double lazy_ms = measure_time([&] {
+            for (int k = 0; k < repeats; ++k)
+                Real r(Long((lazy(a) * 1000).shift(1) + b), b.get_mant());
+        }) / repeats;
+        double add_ms = measure_time([&] {
+            for (int k = 0; k < repeats; ++k)
+                Real r = a + b;
+        }) / repeats;
+        if (a + b != Real(Long((lazy(a) * 1000).shift(1) + b), b.get_mant()))
+            throw std::logic_error("Real +: eager and lazy sums differ");
+
+        std::cout << std::setw(10) << n << std::fixed << std::setprecision(4)
+                  << std::setw(14) << temp_ms
+                  << std::setw(14) << lazy_ms
+                  << std::setw(14) << add_ms
+                  << std::defaultfloat << std::endl;
+    }
+}
+
+void benchmark_real_division() {
+    std::cout << "\n--- Real division and roots, Newton from a double (ms per op) ---" << std::endl;
+    std::cout << std::setw(10) << "limbs"
+              << std::setw(12) << "a / b"
+              << std::setw(12) << "sqrt"
+              << std::setw(12) << "rsqrt" << std::endl;
+    std::mt19937_64 gen(44);
+    for (uint n : {16u, 100u, 1000u, 10000u}) {
+        Real a(random_long(gen, n), n * Long::bs - 2), b(random_long(gen, n), n * Long::bs);
+        a.set_prec(n);
+        const int repeats = std::max(1u, 2000 / n);
+
+        double div_ms = measure_time([&] {
+            for (int k = 0; k < repeats; ++k)
+                Real q = a / b;
+        }) / repeats;
+        double sqrt_ms = measure_time([&] {
+            for (int k = 0; k < repeats; ++k)
+                Real r = sqrt(a);
+        }) / repeats;
+        double rsqrt_ms = measure_time([&] {
+            for (int k = 0; k < repeats; ++k)
+                Real r = rsqrt(a);
+        }) / repeats;
+
+        std::cout << std::setw(10) << n << std::fixed << std::setprecision(4)
+                  << std::setw(12) << div_ms
+                  << std::setw(12) << sqrt_ms
+                  << std::setw(12) << rsqrt_ms
+                  << std::defaultfloat << std::endl;
+    }
+}
+
+// counts what is written and keeps none of it
+struct NullBuffer : std::streambuf {
+    std::streamsize written = 0;
+    int overflow(int c) override { ++written; return c; }
+    std::streamsize xsputn(const char*, std::streamsize n) override { written += n; return n; }
+};
+
+void benchmark_output() {
+    std::cout << "\n--- Printing a Long: whole string vs streamed digits (ms) ---" << std::endl;
+    std::cout << std::setw(12) << "digits"
+              << std::setw(14) << "string"
+              << std::setw(14) << "streamed" << std::endl;
+    std::mt19937_64 gen(45);
+    for (uint n : {100000u, 1000000u, 10000000u}) {
+        Long x = random_long(gen, n / Long::bs);
+
+        NullBuffer sink;
+        std::ostream out(&sink);
+        double string_ms = measure_time([&] { out << std::string(x); });
+        double stream_ms = measure_time([&] { out << x; });
+        std::cout << std::setw(12) << n << std::fixed << std::setprecision(2)
+                  << std::setw(14) << string_ms
+                  << std::setw(14) << stream_ms
+                  << std::defaultfloat << std::endl;
+    }
+}
+
+void benchmark_serialization() {
+    std::cout << "\n--- Saving and loading: decimal text vs binary records (ms) ---" << std::endl;
+    std::cout << std::setw(16) << "value"
+              << std::setw(14) << "text"
+              << std::setw(14) << "binary" << std::endl;
+    std::mt19937_64 gen(46);
+    for (uint n : {1000000u, 10000000u}) {
+        const Long x = random_long(gen, n / Long::bs);
+
+        Long y = null;
+        double text_ms = measure_time([&] { y = Long(std::string(x).c_str()); });
+        if (y != x)
+            throw std::logic_error("Long: the text round trip changed the value");
+        y = null;
+        double binary_ms = measure_time([&] {
+            std::vector<unsigned char> buf;
+            serialize(x, buf);
+            deserialize(buf.data(), buf.size(), y);
+        });
+        if (y != x)
+            throw std::logic_error("Long: the binary round trip changed the value");
+        std::cout << std::setw(9) << n << " digits" << std::fixed << std::setprecision(2)
+                  << std::setw(14) << text_ms
+                  << std::setw(14) << binary_ms
+                  << std::defaultfloat << std::endl;
+    }
+
+    const std::string file = "serialization_benchmark.tmp";
+    for (size_type n : {256, 1024}) {
+        Matrix<double> m = create_random<double>(n, n), r;
+        double text_ms = measure_time([&] {
+            m.save_to_file(file);
+            r = Matrix<double>::load_from_file(file);
+        });
+        if (r != m)
+            throw std::logic_error("Matrix: the text round trip changed the values");
+        r = Matrix<double>();
+        double binary_ms = measure_time([&] {
+            serialize(m, file);
+            deserialize(file, r);
+        });
+        if (r != m)
+            throw std::logic_error("Matrix: the binary round trip changed the values");
+        std::cout << std::setw(9) << n << " matrix" << std::fixed << std::setprecision(2)
+                  << std::setw(14) << text_ms
+                  << std::setw(14) << binary_ms
+                  << std::defaultfloat << std::endl;
+    }
+    std::remove(file.c_str());
+}
+
+void benchmark_mapped_views() {
+    std::cout << "\n--- Opening a record: deserialize vs mapped view, then x mod 9973 (ms) ---" << std::endl;
+    std::cout << std::setw(16) << "value"
+              << std::setw(14) << "deserialize"
+              << std::setw(14) << "map"
+              << std::setw(14) << "mod view" << std::endl;
+    std::mt19937_64 gen(47);
+    const std::string file = "mapped_benchmark.tmp";
+    for (uint n : {1000000u, 10000000u, 100000000u}) {
+        serialize(random_long(gen, n / Long::bs), file);
+
+        Long y = null;
+        double load_ms = measure_time([&] { deserialize(file, y); });
+        double map_ms = measure_time([&] { LongView v(file); });
+        LongView v(file);
+        double mod_ms = measure_time([&] { v.mod_small(9973); });
+        std::cout << std::setw(9) << n << " digits" << std::fixed << std::setprecision(2)
+                  << std::setw(14) << load_ms
+                  << std::setw(14) << map_ms
+                  << std::setw(14) << mod_ms
+                  << std::defaultfloat << std::endl;
+    }
+    std::remove(file.c_str());
+}
+
+void benchmark_matrix_threads(size_t n) {
+    TaskScheduler& scheduler = TaskScheduler::instance();
+    const unsigned all = scheduler.threads();
+    std::cout << "\n--- " << n << " x " << n << " matrix product: 1 thread vs " << all << " (ms) ---" << std::endl;
+    std::cout << std::setw(16) << "algorithm"
+              << std::setw(14) << "1 thread"
+              << std::setw(14) << "all threads"
+              << std::setw(10) << "speedup" << std::endl;
+    using Algo = Matrix<double>::MatrixMultiplicationAlgorithm::AlgorithmType;
+    Matrix<double> a = create_random<double>(n, n), b = create_random<double>(n, n);
+    for (auto [name, algo] : std::vector<std::pair<const char*, Algo>>{
+             {"Naive", Algo::NAIVE}, {"Blocked GEMM", Algo::BLOCKED_GEMM},
+             {"Strassen", Algo::STRASSEN}, {"Winograd", Algo::WINOGRAD}, {"AlphaTensor", Algo::ALPHA_TENSOR}}) {
+        scheduler.set_threads(1);
+        double serial_ms = measure_time([&] { a.multiply(b, algo); });
+        scheduler.set_threads(all);
+        double parallel_ms = measure_time([&] { a.multiply(b, algo); });
+        std::cout << std::setw(16) << name << std::fixed << std::setprecision(2)
+                  << std::setw(14) << serial_ms
+                  << std::setw(14) << parallel_ms
+                  << std::setw(9) << serial_ms / parallel_ms << "x"
+                  << std::defaultfloat << std::endl;
+    }
+}
+
+void benchmark_bigfloat_at(unsigned bits, int repeats) {
+    std::mt19937_64 gen(bits);
+    auto random_fraction = [&] {
+        std::vector<ull> w(bits / 64);
+        for (auto& x : w)
+            x = gen();
+        w.back() |= 1ull << 63;
+        return ldexp(BigFloat(Long::from_words(w), bits), -(long long)bits);
+    };
+    const BigFloat x = random_fraction(), y = random_fraction();
+
+    // Real at the same number of decimal digits, kept to that many limbs
+    const uint limbs = (uint)(bits * 0.30103 / Long::bs) + 1;
+    Real qx(ldexp(x, bits).to_long(), limbs * Long::bs), qy(ldexp(y, bits).to_long(), limbs * Long::bs);
+    qx.set_prec(limbs);
+    qy.set_prec(limbs);
+
+    BigFloat r;
+    double real_ms = measure_time([&] {
+        for (int k = 0; k < repeats; ++k) {
+            Real t = qx * qy;
+            t.cut(limbs);
+        }
+    }) / repeats;
+    double real_div_ms = measure_time([&] {
+        for (int k = 0; k < repeats; ++k)
+            Real t = qx / qy;
+    }) / repeats;
+    double real_sqrt_ms = measure_time([&] {
+        for (int k = 0; k < repeats; ++k)
+            Real t = sqrt(qx, limbs);
+    }) / repeats;
+    double mul_ms = measure_time([&] {
+        for (int k = 0; k < repeats; ++k)
+            r = mul(x, y, bits);
+    }) / repeats;
+    double div_ms = measure_time([&] {
+        for (int k = 0; k < repeats; ++k)
+            r = div(x, y, bits);
+    }) / repeats;
+    double sqrt_ms = measure_time([&] {
+        for (int k = 0; k < repeats; ++k)
+            r = sqrt(x, bits);
+    }) / repeats;
+
+    std::cout << std::setw(10) << bits << std::fixed << std::setprecision(4)
+              << std::setw(14) << real_ms
+              << std::setw(14) << real_div_ms
+              << std::setw(14) << real_sqrt_ms
+              << std::setw(14) << mul_ms
+              << std::setw(14) << div_ms
+              << std::setw(14) << sqrt_ms
+              << std::defaultfloat << std::endl;
+}
+
+void benchmark_bigfloat() {
+    std::cout << "\n--- BigFloat, correctly rounded to the given bits (ms per op) ---" << std::endl;
+    std::cout << std::setw(10) << "bits"
+              << std::setw(14) << "Real mul"
+              << std::setw(14) << "Real div"
+              << std::setw(14) << "Real sqrt"
+              << std::setw(14) << "mul"
+              << std::setw(14) << "div"
+              << std::setw(14) << "sqrt" << std::endl;
+    benchmark_bigfloat_at(1000, 50);
+    benchmark_bigfloat_at(10000, 3);
+    benchmark_bigfloat_at(40000, 1);
+}
+
+// ascending, so every size is computed afresh rather than cut from the cache
+void benchmark_constants(uint max_digits) {
+    std::cout << "\n--- Constants by binary splitting (ms) ---" << std::endl;
+    std::cout << std::setw(10) << "digits"
+              << std::setw(12) << "pi"
+              << std::setw(12) << "e"
+              << std::setw(12) << "log 2"
+              << std::setw(12) << "sqrt 2" << std::endl;
+    for (uint digits = 10000; digits <= max_digits; digits *= 10) {
+        std::cout << std::setw(10) << digits << std::fixed << std::setprecision(1);
+        for (Real (*compute)(uint) : { compute_pi, compute_e, compute_log2, compute_sqrt2 })
+            std::cout << std::setw(12) << measure_time([&] { compute(digits); }) << std::flush;
+        std::cout << std::defaultfloat << std::endl;
+    }
+}
+
+void benchmark_elementary() {
+    std::cout << "\n--- Elementary functions of e - 2 (ms) ---" << std::endl;
+    std::cout << std::setw(10) << "digits"
+              << std::setw(12) << "exp"
+              << std::setw(12) << "log"
+              << std::setw(12) << "sin"
+              << std::setw(12) << "cos"
+              << std::setw(12) << "atan"
+              << std::setw(12) << "pow" << std::endl;
+    const Real x = compute_e(1000) - Real(Long(2), 0);
+    const Real y(Long(15), 1);
+    for (uint digits : {100u, 1000u, 10000u}) {
+        std::cout << std::setw(10) << digits << std::fixed << std::setprecision(1);
+        typedef Real (*Function)(const Real&, uint);
+        for (Function f : std::initializer_list<Function>{ exp, log, sin, cos, atan })
+            std::cout << std::setw(12) << measure_time([&] { f(x, digits); }) << std::flush;
+        std::cout << std::setw(12) << measure_time([&] { pow(x, y, digits); })
+                  << std::defaultfloat << std::endl;
+    }
+}
+
 int main(int argc, char* argv[]) {
     // Default matrix size
     size_t N = 10;
     int num_iterations = 100;
+    uint constant_digits = 100000; // 10000000 for the 10^6 and 10^7 digit runs
     
     // Parse command line arguments
     if (argc > 1) {
@@ -179,6 +728,9 @@ int main(int argc, char* argv[]) {
     if (argc > 2) {
         num_iterations = std::stoi(argv[2]);
     }
+    if (argc > 3) {
+        constant_digits = std::stoul(argv[3]);
+    }
     
     std::cout << "=== Matrix Multiplication Performance Test ===" << std::endl;
     std::cout << "Matrix size: " << N << "x" << N << std::endl;
@@ -237,6 +789,16 @@ int main(int argc, char* argv[]) {
         results.emplace_back("SIMD Naive (AVX2)", simd_stats);
 #endif
 
+        // Blocked GEMM (packed panels, register-tiled micro-kernel)
+        auto gemm_stats = test_algorithm<double>(
+            "Blocked GEMM Algorithm",
+            Matrix<double>::MatrixMultiplicationAlgorithm::AlgorithmType::BLOCKED_GEMM,
+            num_iterations,
+            N
+        );
+        print_stats("Blocked GEMM Algorithm", gemm_stats);
+        results.emplace_back("Blocked GEMM", gemm_stats);
+
         // ARM NEON
 #ifdef __ARM_NEON
         auto neon_stats = test_algorithm<double>(
@@ -315,6 +877,21 @@ int main(int argc, char* argv[]) {
     std::cout << "Fastest algorithm: " << fastest->first << " (" << fastest->second.mean_time << " ms)" << std::endl;
     std::cout << "Slowest algorithm: " << slowest->first << " (" << slowest->second.mean_time << " ms)" << std::endl;
     std::cout << "Speedup range: " << (slowest->second.mean_time / fastest->second.mean_time) << "x" << std::endl;
+
+    benchmark_matrix_threads(N);
+    benchmark_limb_kernels();
+    benchmark_fixed_long();
+    benchmark_limb_alloc();
+    benchmark_accumulator();
+    benchmark_real_short_mul();
+    benchmark_real_add();
+    benchmark_real_division();
+    benchmark_output();
+    benchmark_serialization();
+    benchmark_mapped_views();
+    benchmark_bigfloat();
+    benchmark_constants(constant_digits);
+    benchmark_elementary();
     
     std::cout << "\nTest completed successfully!" << std::endl;
     
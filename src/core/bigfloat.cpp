@@ -0,0 +1,330 @@
+#include "core/bigfloat.h"
+#include <stdexcept>
+
+Long BigFloat::shl(const Long& x, ull k)
+{
+	return abs(x) << (uint)k;
+}
+
+Long BigFloat::shr(const Long& x, ull k, bool& sticky)
+{
+	return abs(x).shift_right((uint)k, sticky);
+}
+
+BigFloat BigFloat::round(Long mant, long long exp, bool sticky, uint p, Rounding r)
+{
+	if (p == 0)
+		throw std::invalid_argument("BigFloat: precision must be positive");
+	BigFloat res;
+	res.prec = p;
+	if (mant.is_zero())
+		return res;
+
+	bool neg = mant < null;
+	mant = abs(mant);
+	long long bl = mant.bit_length();
+	if (bl <= (long long)p && !sticky) {
+		res.m = neg ? -mant : mant;
+		res.e = exp;
+		return res;
+	}
+	if (bl <= (long long)p) {
+		// the sticky bit needs room below the last kept bit and the rounding bit
+		ull g = p + 2 - bl;
+		mant = shl(mant, g);
+		exp -= g;
+		bl = p + 2;
+	}
+
+	ull k = bl - p;
+	Long t = shr(mant, k - 1, sticky);
+	bool half = isodd(t);
+	Long q = t >> 1;
+	exp += k;
+
+	bool inc = false;
+	switch (r) {
+	case nearest:     inc = half && (sticky || isodd(q)); break;
+	case toward_zero: inc = false; break;
+	case up:          inc = !neg && (half || sticky); break;
+	case down:        inc = neg && (half || sticky); break;
+	case away:        inc = half || sticky; break;
+	}
+	if (inc) {
+		q += pone;
+		if (q.bit_length() > p) { // 2^p
+			q = q >> 1;
+			++exp;
+		}
+	}
+	res.m = neg ? -q : q;
+	res.e = exp;
+	return res;
+}
+
+BigFloat::BigFloat() : m(0), e(0), prec(default_prec) {}
+
+BigFloat::BigFloat(double v, uint prec, Rounding r) : BigFloat()
+{
+	if (std::isnan(v) || std::isinf(v))
+		throw std::domain_error("BigFloat: not a finite number");
+	int x = 0;
+	double f = std::frexp(v, &x); // v == f * 2^x, 0.5 <= |f| < 1
+	*this = round(Long((long long)std::ldexp(f, 53)), (long long)x - 53, false, prec, r);
+}
+
+BigFloat::BigFloat(const Long& v, uint prec, Rounding r) : BigFloat()
+{
+	*this = round(v, 0, false, prec, r);
+}
+
+// a Real is its digits over 10^mantissa_place
+BigFloat::BigFloat(const Real& v, uint prec, Rounding r) : BigFloat()
+{
+	const Long& digits = v;
+	uint bits = std::max(digits.bit_length(), 1u);
+	BigFloat num(digits, bits);
+	if (v.get_mant() == 0) {
+		*this = round(num.m, num.e, false, prec, r);
+		return;
+	}
+	Long den = pow(Long(10), Long(v.get_mant()));
+	*this = div(num, BigFloat(den, std::max(den.bit_length(), 1u)), prec, r);
+}
+
+BigFloat& BigFloat::set_precision(uint p, Rounding r)
+{
+	return *this = round(m, e, false, p, r);
+}
+
+double BigFloat::to_double() const
+{
+	BigFloat t = round(m, e, false, 53, nearest);
+	double v = (double)t.m.low_bits();
+	return std::ldexp(t.sign() < 0 ? -v : v, (int)std::max(std::min(t.e, 4096ll), -4096ll));
+}
+
+Long BigFloat::to_long() const
+{
+	bool sticky = false;
+	Long r = (e >= 0) ? shl(m, e) : shr(m, -e, sticky);
+	return (sign() < 0) ? -r : r;
+}
+
+// m * 2^e == m * 5^-e / 10^-e for e < 0: the digits of m * 5^-e with the point moved
+std::string BigFloat::to_string(uint digits) const
+{
+	std::string ip, fp;
+	if (e >= 0)
+		ip = std::string(shl(m, e));
+	else {
+		std::string s = std::string(abs(m) * pow(Long(5), Long(-e)));
+		ull k = -e;
+		if (s.size() <= k)
+			s = std::string(k + 1 - s.size(), '0') + s;
+		ip = s.substr(0, s.size() - k);
+		fp = s.substr(s.size() - k);
+	}
+
+	if (digits > 0) {
+		if (ip != "0")
+			fp.resize(std::min<size_t>(fp.size(), ip.size() < digits ? digits - ip.size() : 0));
+		else {
+			size_t z = fp.find_first_not_of('0');
+			if (z != std::string::npos)
+				fp.resize(std::min<size_t>(fp.size(), z + digits));
+		}
+	}
+	while (!fp.empty() && fp.back() == '0')
+		fp.pop_back();
+
+	std::string s = (sign() < 0) ? "-" : "";
+	s += ip;
+	if (!fp.empty())
+		s += "." + fp;
+	return s;
+}
+
+int BigFloat::compare(const BigFloat& b) const
+{
+	int sa = sign(), sb = b.sign();
+	if (sa != sb)
+		return (sa < sb) ? -1 : 1;
+	if (sa == 0)
+		return 0;
+
+	long long ta = e + m.bit_length(), tb = b.e + b.m.bit_length();
+	if (ta != tb)
+		return (ta < tb) ? -sa : sa;
+	// same top bit, so the exponents differ by less than the larger mantissa
+	int c = (e >= b.e) ? shl(m, e - b.e).compare_abs(b.m) : m.compare_abs(shl(b.m, b.e - e));
+	return c * sa;
+}
+
+BigFloat BigFloat::operator-() const
+{
+	BigFloat r = *this;
+	r.m = -m;
+	return r;
+}
+
+BigFloat BigFloat::operator+(const BigFloat& b) const
+{
+	return add(*this, b, std::max(prec, b.prec));
+}
+
+BigFloat BigFloat::operator-(const BigFloat& b) const
+{
+	return sub(*this, b, std::max(prec, b.prec));
+}
+
+BigFloat BigFloat::operator*(const BigFloat& b) const
+{
+	return mul(*this, b, std::max(prec, b.prec));
+}
+
+BigFloat BigFloat::operator/(const BigFloat& b) const
+{
+	return div(*this, b, std::max(prec, b.prec));
+}
+
+BigFloat add(const BigFloat& a, const BigFloat& b, uint prec, BigFloat::Rounding r)
+{
+	if (a.is_zero() || b.is_zero()) {
+		const BigFloat& x = a.is_zero() ? b : a;
+		return BigFloat::round(x.m, x.e, false, prec, r);
+	}
+
+	long long ta = a.e + a.m.bit_length(), tb = b.e + b.m.bit_length();
+	const BigFloat& x = (ta >= tb) ? a : b;
+	const BigFloat& y = (ta >= tb) ? b : a;
+	long long tx = std::max(ta, tb), ty = std::min(ta, tb);
+
+	// y lies wholly below both the last bit of x and the rounding position:
+	// it only decides the direction, so it is replaced by a sticky unit
+	long long pos = std::min(x.e, tx - (long long)prec - 2);
+	if (ty < pos) {
+		Long s = BigFloat::shl(x.m, x.e - (pos - 2));
+		if (x.sign() < 0)
+			s.changeSign(-1);
+		s += (y.sign() > 0) ? pone : mone;
+		return BigFloat::round(s, pos - 2, true, prec, r);
+	}
+
+	long long emin = std::min(a.e, b.e);
+	Long sa = BigFloat::shl(a.m, a.e - emin), sb = BigFloat::shl(b.m, b.e - emin);
+	if (a.sign() < 0) sa.changeSign(-1);
+	if (b.sign() < 0) sb.changeSign(-1);
+	return BigFloat::round(sa + sb, emin, false, prec, r);
+}
+
+BigFloat sub(const BigFloat& a, const BigFloat& b, uint prec, BigFloat::Rounding r)
+{
+	return add(a, -b, prec, r);
+}
+
+BigFloat mul(const BigFloat& a, const BigFloat& b, uint prec, BigFloat::Rounding r)
+{
+	return BigFloat::round(a.m * b.m, a.e + b.e, false, prec, r);
+}
+
+// the integer part of v / 10^m
+static Long trunc10(const Long& v, uint m)
+{
+	static const int pw[] = { 1, 10, 100, 1000 };
+	const limb_vector& l = v.container();
+	uint drop = m / Long::bs;
+	if (drop >= l.size())
+		return null;
+	Long r = Long::from_limbs(l.data() + drop, l.size() - drop), rem = null;
+	return (m % Long::bs) ? r.divide(pw[m % Long::bs], rem) : r;
+}
+
+// floor(n / d) by Newton's reciprocal of d (Real), a few limbs longer than
+// the quotient: the guess is a unit or two off at most, the remainder puts it right
+static Long floor_divide(const Long& n, const Long& d, Long& rem)
+{
+	Real inv = reciprocal(d, n.size() - d.size() + 4);
+	Long q = trunc10(n * inv, inv.get_mant());
+	rem = n - q * d;
+	while (rem < null) {
+		q -= pone;
+		rem += d;
+	}
+	while (rem >= d) {
+		q += pone;
+		rem -= d;
+	}
+	return q;
+}
+
+// the numerator is widened until the quotient has prec + 2 bits,
+// the remainder only says whether anything is left
+BigFloat div(const BigFloat& a, const BigFloat& b, uint prec, BigFloat::Rounding r)
+{
+	if (b.is_zero())
+		throw std::runtime_error("Division by zero!");
+	if (a.is_zero())
+		return BigFloat::round(null, 0, false, prec, r);
+
+	long long s = std::max(0ll, (long long)prec + 2 + b.m.bit_length() - a.m.bit_length());
+	Long rem = null, n = BigFloat::shl(a.m, s), d = abs(b.m);
+	Long q = floor_divide(n, d, rem);
+	if (a.sign() != b.sign())
+		q.changeSign(-1);
+	return BigFloat::round(q, a.e - b.e - s, !rem.is_zero(), prec, r);
+}
+
+// floor(sqrt(n)) from Real's sqrt, an rsqrt iteration of products only, two
+// limbs past the root; rem = n - root^2 must then lie in [0, 2 root]
+static Long isqrt(const Long& n, Long& rem)
+{
+	Real y = sqrt(Real(n), n.size() / 2 + 3);
+	Long root = trunc10(y, y.get_mant());
+	rem = n - root * root;
+	while (rem < null) {
+		root -= pone;
+		rem += root + root + pone;
+	}
+	while (rem > root + root) {
+		rem -= root + root + pone;
+		root += pone;
+	}
+	return root;
+}
+
+BigFloat sqrt(const BigFloat& a, uint prec, BigFloat::Rounding r)
+{
+	if (a.sign() < 0)
+		throw std::domain_error("BigFloat: sqrt of a negative number");
+	if (a.is_zero())
+		return BigFloat::round(null, 0, false, prec, r);
+
+	// at least 2 (prec + 2) bits under the root, and an even exponent
+	long long bl = a.m.bit_length();
+	long long g = std::max(0ll, 2 * ((long long)prec + 2) - bl);
+	if ((a.e - g) % 2 != 0)
+		++g;
+	Long n = BigFloat::shl(a.m, g), rem = null;
+	Long root = isqrt(n, rem);
+	return BigFloat::round(root, (a.e - g) / 2, !rem.is_zero(), prec, r);
+}
+
+BigFloat sqrt(const BigFloat& a)
+{
+	return sqrt(a, a.precision());
+}
+
+BigFloat ldexp(const BigFloat& a, long long k)
+{
+	BigFloat r = a;
+	r.e += k;
+	return r;
+}
+
+std::ostream& operator<<(std::ostream& stream, const BigFloat& x)
+{
+	// enough decimal digits to tell the binary neighbours apart
+	stream << x.to_string((uint)(x.precision() * 0.30103) + 2);
+	return stream;
+}
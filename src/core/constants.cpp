@@ -0,0 +1,126 @@
+#include "core/constants.h"
+#include "core/binary_split.h"
+#include <mutex>
+
+// Each constant is a series of small integer terms summed by binary
+// splitting (binary_split.h), one reciprocal at the end.
+
+Real truncate(const Real& x, uint digits)
+{
+	static const int pw[] = { 1, 10, 100, 1000 };
+	uint m = x.get_mant();
+	if (m <= digits)
+		return x;
+	uint k = m - digits;
+	const Long& v = x;
+	if (k / Long::bs >= v.size())
+		return Real(null, 0);
+	Long r = Long::from_limbs(v.container().data() + k / Long::bs, v.size() - k / Long::bs, v < 0);
+	if (k % Long::bs)
+		r /= pw[k % Long::bs];
+	return Real(std::move(r), digits);
+}
+
+// 1 / pi = 12 sum (-1)^k (6k)! (13591409 + 545140134 k) / ((3k)! k!^3 640320^(3k + 3/2))
+static Long chud_a(ull k) { return Long(13591409) + Long(545140134) * Long(k); }
+static Long chud_p(ull k)
+{
+	if (k == 0)
+		return pone;
+	return -(Long(6 * k - 5) * Long((2 * k - 1) * (6 * k - 1)));
+}
+static Long chud_q(ull k)
+{
+	if (k == 0)
+		return pone;
+	return Long(k * k) * Long(k) * Long(10939058860032000ull); // 640320^3 / 24
+}
+
+static Real pi_digits(uint digits)
+{
+	uint limbs = digits / Long::bs + 3;
+	SplitSum s = binary_split(chud_a, unit_term(), chud_p, chud_q, 0, 0, digits / 14 + 2); // 14.18 digits a term
+
+	// pi = 426880 sqrt(10005) Q / T
+	Real r(s.Q * Long(426880), 0);
+	r.set_prec(limbs);
+	r = r * sqrt(Real(Long(10005), 0), limbs) * reciprocal(s.T, limbs);
+	return truncate(r, digits);
+}
+
+static Long e_q(ull k) { return (k == 0) ? pone : Long(k); }
+
+static Real e_digits(uint digits)
+{
+	uint limbs = digits / Long::bs + 3;
+	ull n = 1;
+	for (long double lg = 0; lg < digits + 2; lg += std::log10((long double)++n)) {}
+	SplitSum s = binary_split(unit_term(), unit_term(), unit_term(), e_q, 0, 0, n + 1);
+
+	Real r(s.T, 0);
+	r.set_prec(limbs);
+	r = r * reciprocal(s.Q, limbs);
+	return truncate(r, digits);
+}
+
+static Long log2_b(ull k) { return Long(2 * k + 1); }
+static Long log2_q(ull k) { return (k == 0) ? pone : Long(9); }
+
+static Real log2_digits(uint digits)
+{
+	uint limbs = digits / Long::bs + 3;
+	SplitSum s = binary_split(unit_term(), log2_b, unit_term(), log2_q, 0, 0, (ull)(digits / 0.954) + 2);
+
+	// log 2 = 2 T / (3 B Q)
+	Real r(s.T * Long(2), 0);
+	r.set_prec(limbs);
+	r = r * reciprocal(s.B * s.Q * Long(3), limbs);
+	return truncate(r, digits);
+}
+
+static Real sqrt2_digits(uint digits)
+{
+	return truncate(sqrt(Real(Long(2), 0), digits / Long::bs + 3), digits);
+}
+
+// the longest result of one constant so far
+struct Cached
+{
+	std::mutex lock;
+	uint digits = 0;
+	Real value = Real(null, 0);
+};
+
+static Real cached(Cached& c, uint digits, Real (*compute)(uint))
+{
+	std::lock_guard<std::mutex> guard(c.lock);
+	if (c.digits < digits || c.digits == 0) {
+		c.value = compute(digits);
+		c.digits = digits;
+	}
+	return truncate(c.value, digits);
+}
+
+Real compute_pi(uint digits)
+{
+	static Cached c;
+	return cached(c, digits, pi_digits);
+}
+
+Real compute_e(uint digits)
+{
+	static Cached c;
+	return cached(c, digits, e_digits);
+}
+
+Real compute_log2(uint digits)
+{
+	static Cached c;
+	return cached(c, digits, log2_digits);
+}
+
+Real compute_sqrt2(uint digits)
+{
+	static Cached c;
+	return cached(c, digits, sqrt2_digits);
+}
@@ -0,0 +1,376 @@
+#include "core/elementary.h"
+#include "core/constants.h"
+#include "core/binary_split.h"
+#include "core/math.h"
+#include <stdexcept>
+
+// Inside, numbers are fixed point: a Long X of L fraction limbs is X / base^L.
+
+static const uint guard = 3; // limbs kept past the places asked for
+static const ull pw10[] = { 1, 10, 100, 1000 };
+
+// x / 10^m as L fraction limbs, toward zero; m may be negative
+static Long to_fixed(const Long& x, long long m, uint L)
+{
+	if (x.is_zero())
+		return null;
+	long long e = (long long)L * Long::bs - m;
+	if (e >= 0) {
+		Long r = (e % Long::bs) ? x.mul_limb(pw10[e % Long::bs]) : x;
+		return r.shift(e / Long::bs);
+	}
+	ull k = -e;
+	if (k / Long::bs >= x.size())
+		return null;
+	Long r = Long::from_limbs(x.container().data() + k / Long::bs, x.size() - k / Long::bs, x < 0);
+	if (k % Long::bs)
+		r /= (int)pw10[k % Long::bs];
+	return r;
+}
+
+static Long to_fixed(const Real& x, uint L)
+{
+	return to_fixed(x, x.get_mant(), L);
+}
+
+static Long one(uint L)
+{
+	return Long(1).shift(L);
+}
+
+// base^2L / x: 1 / x in fixed point, x > 0 of L fraction limbs
+static Long inv_fixed(const Long& x, uint L)
+{
+	return to_fixed(reciprocal(x, L + 2), 2 * L);
+}
+
+// log10 |x / 10^m| from the top limbs; -inf for 0
+static long double log10_abs(const Long& x, long long m)
+{
+	uint n = x.size(), top = std::min(n, 4u);
+	long double t = 0;
+	for (uint i = 0; i < top; ++i)
+		t = t * Long::base + x[n - 1 - i];
+	return std::log10(t) + (long double)(n - top) * Long::bs - m;
+}
+
+static long double approx(const Long& x, long long m)
+{
+	long double v = std::pow(10.0L, log10_abs(x, m));
+	return (x < 0) ? -v : v;
+}
+
+static long double approx(const Real& x)
+{
+	return approx(x, x.get_mant());
+}
+
+// The bit-burst pieces of |x| < 1 (L fraction limbs): a / base^d with a
+// made of the fraction limbs 2^j to 2^(j+1) - 1 and d = 2^(j+1) - 1. The
+// series of a piece converges by at least 2^j limbs a term, so every piece
+// costs about the same, and there are log L of them.
+struct Chunk
+{
+	Long a;
+	uint d;
+};
+
+static vector<Chunk> chunks(const Long& x, uint L)
+{
+	vector<Chunk> c;
+	const limb_vector& v = x.container();
+	for (uint lo = 1; lo <= L; lo *= 2) {
+		uint hi = std::min(2 * lo - 1, L);         // positions below the point, the first is 1
+		uint from = L - hi, to = std::min(L - lo + 1, x.size()); // the limbs of x holding them
+		if (from >= to)
+			continue;
+		Long a = Long::from_limbs(v.data() + from, to - from, x < 0);
+		if (!a.is_zero())
+			c.push_back({ std::move(a), hi });
+	}
+	return c;
+}
+
+// sum over k in [1, n] of prod over j in [1, k] of p(j) / (q(j) base^d) as L
+// fraction limbs, by binary splitting with the powers of base as shifts
+template <class Fp, class Fq>
+static Long series(const Fp& p, const Fq& q, uint d, ull n, uint L)
+{
+	SplitSum s = binary_split(unit_term(), unit_term(), p, q, d, 1, n + 1);
+	Real r(s.T, 0);
+	r.set_prec(L + 2);
+	r = r * reciprocal(s.Q, L + 2);
+	return to_fixed(r, (long long)r.get_mant() + (long long)d * n * Long::bs, L);
+}
+
+// terms until v^(s k) / (s k)! is below base^-(L + 1), with lv = log10 |v| < 0
+static ull terms(long double lv, uint s, uint L)
+{
+	const long double target = -(long double)(L + 1) * Long::bs;
+	long double lt = 0;
+	ull k = 0;
+	for (ull f = 0; lt > target; ++k)
+		for (uint i = 0; i < s; ++i)
+			lt += lv - std::log10((long double)++f);
+	return k;
+}
+
+// exp(x) for |x| < 1, L fraction limbs
+static Long exp_fixed(const Long& x, uint L)
+{
+	Long r = one(L);
+	for (const Chunk& c : chunks(x, L)) {
+		ull n = terms(log10_abs(c.a, (long long)c.d * Long::bs), 1, L);
+		const Long& a = c.a;
+		Long s = series([&](ull) { return a; }, [](ull k) { return Long(k); }, c.d, n, L);
+		r = r.mul_high(one(L) + s, L);
+	}
+	return r;
+}
+
+// sin(x) and cos(x) for |x| < 1, L fraction limbs, by the addition formulas over the pieces
+static void sincos_fixed(const Long& x, uint L, Long& s, Long& c)
+{
+	s = null;
+	c = one(L);
+	for (const Chunk& ch : chunks(x, L)) {
+		ull n = terms(log10_abs(ch.a, (long long)ch.d * Long::bs), 2, L);
+		const Long a2 = -(ch.a * ch.a);
+		auto p = [&](ull) { return a2; };
+		Long cc = one(L) + series(p, [](ull k) { return Long((2 * k - 1) * (2 * k)); }, 2 * ch.d, n, L);
+		Long sc = (one(L) + series(p, [](ull k) { return Long(2 * k * (2 * k + 1)); }, 2 * ch.d, n, L)).mul_high(ch.a, ch.d);
+		Long ns = s.mul_high(cc, L) + c.mul_high(sc, L);
+		c = c.mul_high(cc, L) - s.mul_high(sc, L);
+		s = std::move(ns);
+	}
+}
+
+// Newton's precisions: L, L / 2 + 1, ... down to 3 limbs or fewer, smallest first.
+// The start, from a double, is good to 15 digits.
+static vector<uint> steps(uint L)
+{
+	vector<uint> s = { L };
+	do
+		s.push_back(s.back() / 2 + 1);
+	while (s.back() > 3);
+	std::reverse(s.begin(), s.end());
+	return s;
+}
+
+static Long seed(long double v, uint L)
+{
+	return to_fixed(Long((long long)(v * 1e15L)), 15, L);
+}
+
+// x at more limbs, for the next Newton step
+static Long widen(Long x, uint from, uint to)
+{
+	if (!x.is_zero())
+		x.shift(to - from);
+	return x;
+}
+
+Real exp(const Real& x, uint digits)
+{
+	long double lx = approx(x);
+	if (lx * 0.4342944819L < -(long double)digits - 1) // below 10^-digits
+		return Real(null, 0);
+	if (lx > 1e15L)
+		throw std::overflow_error("exp: result too large");
+
+	// exp(x) = 2^n exp(r), |r| <= log(2) / 2; the places asked for and the
+	// integer digits of the result are what exp(r) needs
+	long long n = std::llround(lx / 0.6931471805599453094L);
+	long double rel = digits + n * 0.30102999566L;
+	uint L = (uint)(std::max(rel, 0.0L) / Long::bs) + guard;
+	uint E = L + (uint)(std::log10(std::fabs((long double)n) + 1) / Long::bs) + 1;
+	Long r = to_fixed(x, E) - to_fixed(compute_log2((E + 1) * Long::bs), E) * Long(n);
+	Long e = exp_fixed(to_fixed(r, (long long)E * Long::bs, L), L);
+
+	// 2^-n = 5^n / 10^n
+	Real y = (n >= 0) ? Real(e * pow(Long(2), Long(n)), L * Long::bs)
+	                  : Real(e * pow(Long(5), Long(-n)), L * Long::bs - n);
+	return truncate(y, digits);
+}
+
+Real log(const Real& x, uint digits)
+{
+	const Long& v = x;
+	if (v.is_zero() || v < 0)
+		throw std::domain_error("log: argument must be positive");
+
+	// x = 2^k y with y between 0.7 and 1.42
+	long long k = std::llround(log10_abs(v, x.get_mant()) / 0.30102999566L);
+	Real y = (k >= 0) ? Real(v * pow(Long(5), Long(k)), x.get_mant() + k)
+	                  : Real(v * pow(Long(2), Long(-k)), x.get_mant());
+
+	// z += y exp(-z) - 1: Newton's step for exp(z) = y
+	uint L = digits / Long::bs + guard;
+	Long yf = to_fixed(y, L);
+	vector<uint> s = steps(L);
+	Long z = seed(std::log(approx(y)), s[0]);
+	for (size_t i = 1; i < s.size(); ++i) {
+		uint l = s[i];
+		z = widen(std::move(z), s[i - 1], l);
+		Long yl = to_fixed(yf, (long long)L * Long::bs, l);
+		z = z + yl.mul_high(exp_fixed(-z, l), l) - one(l);
+	}
+
+	Real l2 = compute_log2(digits + 2 * Long::bs + (uint)std::log10(std::fabs((long double)k) + 1));
+	return truncate(Real(z, L * Long::bs) + Real(Long(k), 0) * l2, digits);
+}
+
+// x - q pi / 2, at most pi / 4 in size, as L fraction limbs
+static Long reduce_half_pi(const Real& x, uint L, long long& q)
+{
+	long double lx = approx(x);
+	if (!(std::fabs(lx) < 1e15L))
+		throw std::overflow_error("sin, cos: argument too large");
+	q = std::llround(lx / 1.5707963267948966192L);
+	uint E = L + (uint)(std::log10(std::fabs((long double)q) + 1) / Long::bs) + 1;
+	Long h = to_fixed(compute_pi((E + 1) * Long::bs) * Real(Long(5), 1), E);
+	return to_fixed(to_fixed(x, E) - h * Long(q), (long long)E * Long::bs, L);
+}
+
+static Real sin_quadrant(const Real& x, uint digits, int shift)
+{
+	uint L = digits / Long::bs + guard;
+	long long q = 0;
+	Long r = reduce_half_pi(x, L, q);
+	Long s = null, c = null;
+	sincos_fixed(r, L, s, c);
+
+	// sin(r + q pi / 2)
+	Long res = null;
+	switch ((((q + shift) % 4) + 4) % 4) {
+	case 0: res = s; break;
+	case 1: res = c; break;
+	case 2: res = -s; break;
+	case 3: res = -c; break;
+	}
+	return truncate(Real(res, L * Long::bs), digits);
+}
+
+Real sin(const Real& x, uint digits)
+{
+	return sin_quadrant(x, digits, 0);
+}
+
+// cos(x) = sin(x + pi / 2)
+Real cos(const Real& x, uint digits)
+{
+	return sin_quadrant(x, digits, 1);
+}
+
+Real atan(const Real& x, uint digits)
+{
+	const Long& v = x;
+	if (v.is_zero())
+		return Real(null, 0);
+
+	// t = |x| or 1 / |x|, whichever is at most about 1; atan(x) = pi / 2 - atan(1 / x)
+	uint L = digits / Long::bs + guard;
+	bool big = log10_abs(v, x.get_mant()) > 0;
+	Long t = null;
+	if (!big)
+		t = to_fixed(abs(v), x.get_mant(), L);
+	else {
+		Real r = reciprocal(abs(v), L + 2);
+		t = to_fixed(r, (long long)r.get_mant() - x.get_mant(), L);
+	}
+
+	// with d = atan(t) - y, s = sin(y), c = cos(y):
+	// (t c - s)(c + t s) / (1 + t^2) = sin(2d) / 2 = d - O(d^3)
+	vector<uint> s = steps(L);
+	Long y = seed(std::atan(approx(t, (long long)L * Long::bs)), s[0]);
+	for (size_t i = 1; i < s.size(); ++i) {
+		uint l = s[i];
+		y = widen(std::move(y), s[i - 1], l);
+		Long tl = to_fixed(t, (long long)L * Long::bs, l);
+		Long sn = null, cs = null;
+		sincos_fixed(y, l, sn, cs);
+		Long num = tl.mul_high(cs, l) - sn, den = cs + tl.mul_high(sn, l);
+		y = y + num.mul_high(den, l).mul_high(inv_fixed(one(l) + tl.mul_high(tl, l), l), l);
+	}
+
+	Real res(y, L * Long::bs);
+	if (big)
+		res = compute_pi(digits + 2 * Long::bs) * Real(Long(5), 1) - res;
+	if (v < 0)
+		res.changeSign();
+	return truncate(res, digits);
+}
+
+// all the fraction digits of x are zeros
+static bool is_integer(const Real& x)
+{
+	const Long& v = x;
+	uint m = x.get_mant();
+	for (uint i = 0; i < m / Long::bs && i < v.size(); ++i)
+		if (v[i] != 0)
+			return false;
+	if (m / Long::bs >= v.size())
+		return v.is_zero();
+	return v[m / Long::bs] % pw10[m % Long::bs] == 0;
+}
+
+// x^n by squaring, the products keeping the limbs the result needs
+static Real int_pow(const Real& x, long long n, uint digits)
+{
+	ull e = (n < 0) ? -(ull)n : (ull)n;
+	if (e == 0)
+		return Real(pone, 0);
+	// digits of |x|^e before the point, then the places the result needs of it
+	long double mag = e * log10_abs(x, x.get_mant());
+	long double rel = digits + ((n >= 0) ? mag : -mag);
+	if (rel < 0)
+		return Real(null, 0);
+	uint p = (uint)(rel / Long::bs) + guard + (uint)(std::log10((long double)e + 1) / Long::bs) + 1;
+
+	Real r(pone, 0), b = x;
+	r.set_prec(p);
+	b.set_prec(p);
+	for (; e; e >>= 1) {
+		if (e & 1)
+			r = r * b;
+		if (e > 1)
+			b = b * b;
+	}
+	r.set_prec(0);
+	if (n >= 0)
+		return truncate(r, digits);
+
+	// 1 / r = 10^m / digits of r
+	uint L = digits / Long::bs + guard;
+	Real inv = reciprocal(r, p);
+	return truncate(Real(to_fixed(inv, (long long)inv.get_mant() - r.get_mant(), L), L * Long::bs), digits);
+}
+
+Real pow(const Real& x, const Real& y, uint digits)
+{
+	const Long& v = x;
+	const Long& w = y;
+	if (v.is_zero()) {
+		if (w.is_zero())
+			return Real(pone, 0);
+		if (w < 0)
+			throw std::domain_error("pow: zero to a negative power");
+		return Real(null, 0);
+	}
+	if (is_integer(y)) {
+		Long n = to_fixed(y, 0);
+		if (n.bit_length() < 63)
+			return int_pow(x, (w < 0) ? -(long long)n.low_bits() : (long long)n.low_bits(), digits);
+	}
+	if (v < 0)
+		throw std::domain_error("pow: a negative base needs an integer exponent");
+
+	// exp(y log x) has the digits of the result before the point, log x
+	// needs those and the ones y multiplies its error by as well
+	long double lr = approx(y) * log10_abs(v, x.get_mant());
+	if (lr > 1e9L)
+		throw std::overflow_error("pow: result too large");
+	long double ly = std::max(log10_abs(w, y.get_mant()), 0.0L);
+	uint dl = digits + (uint)std::max(lr, 0.0L) + (uint)ly + 2 * Long::bs;
+	return exp(y * log(x, dl), digits);
+}
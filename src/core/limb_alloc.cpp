@@ -0,0 +1,230 @@
+#include "core/limb_alloc.h"
+#include <new>
+#include <vector>
+#include <atomic>
+
+// every block starts with its owner, padded to keep the limbs 16-byte aligned
+struct BlockHeader
+{
+	LimbAllocator* owner;
+	size_t pad;
+};
+
+static thread_local LimbAllocator* current = nullptr;
+static thread_local LimbAllocStats stats = {};
+
+class HeapAllocator : public LimbAllocator
+{
+public:
+	void* allocate(size_t bytes) override
+	{
+		++stats.system;
+		return ::operator new(bytes);
+	}
+	void deallocate(void* p, size_t) override
+	{
+		::operator delete(p);
+	}
+};
+
+// Size classes 2^min_class .. 2^max_class bytes, at most max_cached free
+// blocks each. The free lists belong to the thread that frees a block, so
+// no locking is needed; bigger blocks bypass the pool.
+class PoolAllocator : public LimbAllocator
+{
+	static const unsigned min_class = 6;
+	static const unsigned max_class = 16;
+	static const size_t max_cached = 64;
+
+	struct FreeLists
+	{
+		std::vector<void*> list[max_class + 1];
+		~FreeLists()
+		{
+			for (auto& l : list)
+				for (auto p : l)
+					::operator delete(p);
+		}
+	};
+
+	// plain pointers are never destroyed, so they stay readable while other
+	// thread_local objects are torn down
+	static thread_local FreeLists* lists;
+	static thread_local bool torn_down;
+
+	struct Guard
+	{
+		~Guard()
+		{
+			delete lists;
+			lists = nullptr;
+			torn_down = true;
+		}
+	};
+
+	static FreeLists* local()
+	{
+		if (!lists && !torn_down) {
+			static thread_local Guard guard;
+			(void)guard;
+			lists = new FreeLists;
+		}
+		return lists;
+	}
+
+	static unsigned size_class(size_t bytes)
+	{
+		unsigned c = min_class;
+		while (((size_t)1 << c) < bytes)
+			++c;
+		return c;
+	}
+
+public:
+	void* allocate(size_t bytes) override
+	{
+		unsigned c = size_class(bytes);
+		if (c > max_class) {
+			++stats.system;
+			return ::operator new(bytes);
+		}
+		auto l = local();
+		if (l && !l->list[c].empty()) {
+			void* p = l->list[c].back();
+			l->list[c].pop_back();
+			return p;
+		}
+		++stats.system;
+		return ::operator new((size_t)1 << c);
+	}
+
+	void deallocate(void* p, size_t bytes) override
+	{
+		unsigned c = size_class(bytes);
+		auto l = (c <= max_class) ? local() : nullptr;
+		if (l && l->list[c].size() < max_cached)
+			l->list[c].push_back(p);
+		else
+			::operator delete(p);
+	}
+};
+
+thread_local PoolAllocator::FreeLists* PoolAllocator::lists = nullptr;
+thread_local bool PoolAllocator::torn_down = false;
+
+// The arena counts its live blocks plus one for the open scope and deletes
+// itself (with all chunks) when the count drops to zero.
+class LongArena::State : public LimbAllocator
+{
+	std::vector<char*> chunks;
+	size_t chunk;
+	size_t left;
+	char* top;
+	std::atomic<size_t> refs;
+
+public:
+	size_t used;
+
+	explicit State(size_t c) : chunk(c), left(0), top(nullptr), refs(1), used(0) {}
+	~State()
+	{
+		for (auto p : chunks)
+			::operator delete(p);
+	}
+
+	void* allocate(size_t bytes) override
+	{
+		bytes = (bytes + 15) & ~(size_t)15;
+		if (bytes > left) {
+			size_t n = (bytes > chunk) ? bytes : chunk;
+			++stats.system;
+			top = static_cast<char*>(::operator new(n));
+			chunks.push_back(top);
+			left = n;
+		}
+		void* p = top;
+		top += bytes;
+		left -= bytes;
+		used += bytes;
+		++refs;
+		return p;
+	}
+
+	void deallocate(void*, size_t) override
+	{
+		unref();
+	}
+
+	void unref()
+	{
+		if (--refs == 0)
+			delete this;
+	}
+};
+
+LimbAllocator& heap_limb_allocator()
+{
+	static auto a = new HeapAllocator;
+	return *a;
+}
+
+LimbAllocator& pool_limb_allocator()
+{
+	static auto a = new PoolAllocator;
+	return *a;
+}
+
+LimbAllocator* get_limb_allocator()
+{
+	return current ? current : &pool_limb_allocator();
+}
+
+LimbAllocator* set_limb_allocator(LimbAllocator* alloc)
+{
+	auto prev = get_limb_allocator();
+	current = alloc;
+	return prev;
+}
+
+const LimbAllocStats& limb_alloc_stats()
+{
+	return stats;
+}
+
+void reset_limb_alloc_stats()
+{
+	stats = {};
+}
+
+void* limb_alloc(size_t bytes)
+{
+	auto owner = get_limb_allocator();
+	auto h = static_cast<BlockHeader*>(owner->allocate(bytes + sizeof(BlockHeader)));
+	h->owner = owner;
+	++stats.allocations;
+	stats.bytes += bytes;
+	return h + 1;
+}
+
+void limb_free(void* p, size_t bytes)
+{
+	auto h = static_cast<BlockHeader*>(p) - 1;
+	++stats.releases;
+	h->owner->deallocate(h, bytes + sizeof(BlockHeader));
+}
+
+LongArena::LongArena(size_t chunk) : state(new State(chunk))
+{
+	prev = set_limb_allocator(state);
+}
+
+LongArena::~LongArena()
+{
+	set_limb_allocator(prev);
+	state->unref();
+}
+
+size_t LongArena::bytes_used() const
+{
+	return state->used;
+}
@@ -0,0 +1,590 @@
+#include "core/limb_kernels.h"
+#include <cstring>
+
+#if defined(__x86_64__) && defined(__GNUC__)
+#define LIMB_KERNELS_X86
+#include <immintrin.h>
+#endif
+#if defined(__ARM_NEON) && defined(__aarch64__)
+#define LIMB_KERNELS_NEON
+#include <arm_neon.h>
+#endif
+
+// Carries of a whole vector are resolved at once: lane i generates a carry
+// (g) when its sum is >= base and propagates one (p) when it equals
+// base - 1. With the lanes as bits, the carry into every lane is
+// ((g | p) + g + carry_in) ^ p, the bit above the top lane is the carry out.
+// Subtraction is the same with borrows (g: x < y, p: x == y).
+
+// below this many limbs the vector setup costs more than it saves
+static const size_t simd_min = 8;
+
+static ull add_scalar(ull* r, const ull* x, const ull* y, size_t n, ull c)
+{
+	for (size_t i = 0; i < n; ++i) {
+		ull s = x[i] + y[i] + c;
+		c = s >= limb_base;
+		r[i] = c ? s - limb_base : s;
+	}
+	return c;
+}
+
+static ull sub_scalar(ull* r, const ull* x, const ull* y, size_t n, ull b)
+{
+	for (size_t i = 0; i < n; ++i) {
+		long long d = (long long)x[i] - (long long)y[i] - (long long)b;
+		b = d < 0;
+		r[i] = (ull)(b ? d + (long long)limb_base : d);
+	}
+	return b;
+}
+
+static ull mul_small_scalar(ull* r, const ull* x, size_t n, ull k, ull c)
+{
+	for (size_t i = 0; i < n; ++i) {
+		c += x[i] * k;
+		r[i] = c % limb_base;
+		c /= limb_base;
+	}
+	return c;
+}
+
+static int cmp_scalar(const ull* x, const ull* y, size_t n)
+{
+	while (n-- > 0)
+		if (x[n] != y[n])
+			return x[n] < y[n] ? -1 : 1;
+	return 0;
+}
+
+static ull add_generic(ull* r, const ull* x, const ull* y, size_t n) { return add_scalar(r, x, y, n, 0); }
+static ull sub_generic(ull* r, const ull* x, const ull* y, size_t n) { return sub_scalar(r, x, y, n, 0); }
+static ull mul_small_generic(ull* r, const ull* x, size_t n, ull k) { return mul_small_scalar(r, x, n, k, 0); }
+
+#ifdef LIMB_KERNELS_X86
+
+// lane i of the result is 1 if bit i of m is set
+__attribute__((target("avx2")))
+static inline __m256i lane_bits(unsigned m)
+{
+	const __m256i bits = _mm256_setr_epi64x(1, 2, 4, 8);
+	__m256i t = _mm256_and_si256(_mm256_set1_epi64x(m), bits);
+	return _mm256_srli_epi64(_mm256_cmpeq_epi64(t, bits), 63);
+}
+
+__attribute__((target("avx2")))
+static inline unsigned lane_mask(__m256i v)
+{
+	return (unsigned)_mm256_movemask_pd(_mm256_castsi256_pd(v));
+}
+
+__attribute__((target("avx2")))
+static ull add_avx2(ull* r, const ull* x, const ull* y, size_t n)
+{
+	const __m256i bm1 = _mm256_set1_epi64x(limb_base - 1);
+	const __m256i bv = _mm256_set1_epi64x(limb_base);
+	unsigned c = 0;
+	size_t i = 0;
+	for (; i + 4 <= n; i += 4) {
+		__m256i s = _mm256_add_epi64(_mm256_loadu_si256((const __m256i*)(x + i)),
+			_mm256_loadu_si256((const __m256i*)(y + i)));
+		unsigned g = lane_mask(_mm256_cmpgt_epi64(s, bm1));
+		unsigned p = lane_mask(_mm256_cmpeq_epi64(s, bm1));
+		unsigned t = (g | p) + g + c;
+		c = (t >> 4) & 1;
+		s = _mm256_add_epi64(s, lane_bits((t ^ p) & 15));
+		s = _mm256_sub_epi64(s, _mm256_and_si256(_mm256_cmpgt_epi64(s, bm1), bv));
+		_mm256_storeu_si256((__m256i*)(r + i), s);
+	}
+	return add_scalar(r + i, x + i, y + i, n - i, c);
+}
+
+__attribute__((target("avx2")))
+static ull sub_avx2(ull* r, const ull* x, const ull* y, size_t n)
+{
+	const __m256i bv = _mm256_set1_epi64x(limb_base);
+	const __m256i zero = _mm256_setzero_si256();
+	unsigned b = 0;
+	size_t i = 0;
+	for (; i + 4 <= n; i += 4) {
+		__m256i xv = _mm256_loadu_si256((const __m256i*)(x + i));
+		__m256i yv = _mm256_loadu_si256((const __m256i*)(y + i));
+		unsigned g = lane_mask(_mm256_cmpgt_epi64(yv, xv));
+		unsigned p = lane_mask(_mm256_cmpeq_epi64(xv, yv));
+		unsigned t = (g | p) + g + b;
+		b = (t >> 4) & 1;
+		__m256i d = _mm256_sub_epi64(_mm256_sub_epi64(xv, yv), lane_bits((t ^ p) & 15));
+		d = _mm256_add_epi64(d, _mm256_and_si256(_mm256_cmpgt_epi64(zero, d), bv));
+		_mm256_storeu_si256((__m256i*)(r + i), d);
+	}
+	return sub_scalar(r + i, x + i, y + i, n - i, b);
+}
+
+// limbs below 2 * base brought under base, returns the carry
+__attribute__((target("avx2")))
+static ull carry_avx2(ull* r, size_t n)
+{
+	const __m256i bm1 = _mm256_set1_epi64x(limb_base - 1);
+	const __m256i bv = _mm256_set1_epi64x(limb_base);
+	unsigned c = 0;
+	for (size_t i = 0; i < n; i += 4) {
+		__m256i s = _mm256_loadu_si256((const __m256i*)(r + i));
+		unsigned g = lane_mask(_mm256_cmpgt_epi64(s, bm1));
+		unsigned p = lane_mask(_mm256_cmpeq_epi64(s, bm1));
+		if ((g | c) == 0)
+			continue;
+		unsigned t = (g | p) + g + c;
+		c = (t >> 4) & 1;
+		s = _mm256_add_epi64(s, lane_bits((t ^ p) & 15));
+		s = _mm256_sub_epi64(s, _mm256_and_si256(_mm256_cmpgt_epi64(s, bm1), bv));
+		_mm256_storeu_si256((__m256i*)(r + i), s);
+	}
+	return c;
+}
+
+// Two passes: x * k = q * base + lo per lane (quotient through doubles,
+// exact below 2^52, and one correction step), then lo plus the quotient of
+// the lane below, which is under 2 * base, gets its single carries
+// resolved as in add_avx2. The first pass has no dependency between blocks.
+__attribute__((target("avx2")))
+static ull mul_small_avx2(ull* r, const ull* x, size_t n, ull k)
+{
+	if (k >= limb_base)
+		return mul_small_scalar(r, x, n, k, 0);
+
+	const __m256i kv = _mm256_set1_epi64x(k);
+	const __m256i bv = _mm256_set1_epi64x(limb_base);
+	const __m256i bm1 = _mm256_set1_epi64x(limb_base - 1);
+	const __m256i magic_i = _mm256_set1_epi64x(0x4330000000000000ll);
+	const __m256d magic_d = _mm256_set1_pd(4503599627370496.0); // 2^52
+	const __m256d inv = _mm256_set1_pd(1.0 / limb_base);
+	__m256i prev = _mm256_setzero_si256();
+	size_t m = n & ~(size_t)3;
+	for (size_t i = 0; i < m; i += 4) {
+		__m256i p = _mm256_mul_epu32(_mm256_loadu_si256((const __m256i*)(x + i)), kv);
+		__m256d pd = _mm256_sub_pd(_mm256_castsi256_pd(_mm256_or_si256(p, magic_i)), magic_d);
+		__m256d qd = _mm256_floor_pd(_mm256_mul_pd(pd, inv));
+		__m256i q = _mm256_sub_epi64(_mm256_castpd_si256(_mm256_add_pd(qd, magic_d)), magic_i);
+		__m256i lo = _mm256_sub_epi64(p, _mm256_mul_epu32(q, bv));
+		__m256i hi = _mm256_cmpgt_epi64(lo, bm1);
+		lo = _mm256_sub_epi64(lo, _mm256_and_si256(hi, bv));
+		q = _mm256_sub_epi64(q, hi);
+		__m256i lt = _mm256_cmpgt_epi64(_mm256_setzero_si256(), lo);
+		lo = _mm256_add_epi64(lo, _mm256_and_si256(lt, bv));
+		q = _mm256_add_epi64(q, lt);
+
+		// quotients move one lane up, the top one of the previous block enters lane 0
+		__m256i up = _mm256_blend_epi32(_mm256_permute4x64_epi64(q, _MM_SHUFFLE(2, 1, 0, 3)),
+			_mm256_permute4x64_epi64(prev, _MM_SHUFFLE(2, 1, 0, 3)), 0x03);
+		_mm256_storeu_si256((__m256i*)(r + i), _mm256_add_epi64(lo, up));
+		prev = q;
+	}
+	ull c = (ull)_mm256_extract_epi64(prev, 3) + carry_avx2(r, m);
+	return mul_small_scalar(r + m, x + m, n - m, k, c);
+}
+
+__attribute__((target("avx2")))
+static int cmp_avx2(const ull* x, const ull* y, size_t n)
+{
+	size_t i = n;
+	for (; i >= 4; i -= 4) {
+		__m256i eq = _mm256_cmpeq_epi64(_mm256_loadu_si256((const __m256i*)(x + i - 4)),
+			_mm256_loadu_si256((const __m256i*)(y + i - 4)));
+		unsigned ne = ~lane_mask(eq) & 15;
+		if (ne) {
+			size_t j = i - 4 + (31 - __builtin_clz(ne));
+			return x[j] < y[j] ? -1 : 1;
+		}
+	}
+	return cmp_scalar(x, y, i);
+}
+
+__attribute__((target("avx512f")))
+static ull add_avx512(ull* r, const ull* x, const ull* y, size_t n)
+{
+	const __m512i bm1 = _mm512_set1_epi64(limb_base - 1);
+	const __m512i bv = _mm512_set1_epi64(limb_base);
+	const __m512i one = _mm512_set1_epi64(1);
+	unsigned c = 0;
+	size_t i = 0;
+	for (; i + 8 <= n; i += 8) {
+		__m512i s = _mm512_add_epi64(_mm512_loadu_si512(x + i), _mm512_loadu_si512(y + i));
+		unsigned g = _mm512_cmpgt_epu64_mask(s, bm1);
+		unsigned p = _mm512_cmpeq_epu64_mask(s, bm1);
+		unsigned t = (g | p) + g + c;
+		c = (t >> 8) & 1;
+		s = _mm512_mask_add_epi64(s, (__mmask8)(t ^ p), s, one);
+		s = _mm512_mask_sub_epi64(s, _mm512_cmpgt_epu64_mask(s, bm1), s, bv);
+		_mm512_storeu_si512(r + i, s);
+	}
+	return add_scalar(r + i, x + i, y + i, n - i, c);
+}
+
+__attribute__((target("avx512f")))
+static ull sub_avx512(ull* r, const ull* x, const ull* y, size_t n)
+{
+	const __m512i bv = _mm512_set1_epi64(limb_base);
+	const __m512i one = _mm512_set1_epi64(1);
+	const __m512i zero = _mm512_setzero_si512();
+	unsigned b = 0;
+	size_t i = 0;
+	for (; i + 8 <= n; i += 8) {
+		__m512i xv = _mm512_loadu_si512(x + i);
+		__m512i yv = _mm512_loadu_si512(y + i);
+		unsigned g = _mm512_cmplt_epu64_mask(xv, yv);
+		unsigned p = _mm512_cmpeq_epu64_mask(xv, yv);
+		unsigned t = (g | p) + g + b;
+		b = (t >> 8) & 1;
+		__m512i d = _mm512_sub_epi64(xv, yv);
+		d = _mm512_mask_sub_epi64(d, (__mmask8)(t ^ p), d, one);
+		d = _mm512_mask_add_epi64(d, _mm512_cmplt_epi64_mask(d, zero), d, bv);
+		_mm512_storeu_si512(r + i, d);
+	}
+	return sub_scalar(r + i, x + i, y + i, n - i, b);
+}
+
+// limbs below 2 * base brought under base, returns the carry
+__attribute__((target("avx512f")))
+static ull carry_avx512(ull* r, size_t n)
+{
+	const __m512i bm1 = _mm512_set1_epi64(limb_base - 1);
+	const __m512i bv = _mm512_set1_epi64(limb_base);
+	const __m512i one = _mm512_set1_epi64(1);
+	unsigned c = 0;
+	for (size_t i = 0; i < n; i += 8) {
+		__m512i s = _mm512_loadu_si512(r + i);
+		unsigned g = _mm512_cmpgt_epu64_mask(s, bm1);
+		unsigned p = _mm512_cmpeq_epu64_mask(s, bm1);
+		if ((g | c) == 0)
+			continue;
+		unsigned t = (g | p) + g + c;
+		c = (t >> 8) & 1;
+		s = _mm512_mask_add_epi64(s, (__mmask8)(t ^ p), s, one);
+		s = _mm512_mask_sub_epi64(s, _mm512_cmpgt_epu64_mask(s, bm1), s, bv);
+		_mm512_storeu_si512(r + i, s);
+	}
+	return c;
+}
+
+// mul_small_avx2 eight lanes wide; valignq moves the quotients up a lane
+__attribute__((target("avx512f")))
+static ull mul_small_avx512(ull* r, const ull* x, size_t n, ull k)
+{
+	if (k >= limb_base)
+		return mul_small_scalar(r, x, n, k, 0);
+
+	const __m512i kv = _mm512_set1_epi64(k);
+	const __m512i bv = _mm512_set1_epi64(limb_base);
+	const __m512i bm1 = _mm512_set1_epi64(limb_base - 1);
+	const __m512i one = _mm512_set1_epi64(1);
+	const __m512i zero = _mm512_setzero_si512();
+	const __m512i magic_i = _mm512_set1_epi64(0x4330000000000000ll);
+	const __m512d magic_d = _mm512_set1_pd(4503599627370496.0); // 2^52
+	const __m512d inv = _mm512_set1_pd(1.0 / limb_base);
+	// the masked forms with all lanes set: the plain ones start from an
+	// undefined register, which gcc 12 takes for an uninitialized read
+	const __mmask8 all = 0xff;
+	__m512i prev = zero;
+	size_t m = n & ~(size_t)7;
+	for (size_t i = 0; i < m; i += 8) {
+		__m512i p = _mm512_mask_mul_epu32(zero, all, _mm512_loadu_si512(x + i), kv);
+		__m512d pd = _mm512_sub_pd(_mm512_castsi512_pd(_mm512_or_si512(p, magic_i)), magic_d);
+		__m512d qd = _mm512_mask_roundscale_pd(pd, all, _mm512_mul_pd(pd, inv), _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC);
+		__m512i q = _mm512_sub_epi64(_mm512_castpd_si512(_mm512_add_pd(qd, magic_d)), magic_i);
+		__m512i lo = _mm512_sub_epi64(p, _mm512_mask_mul_epu32(zero, all, q, bv));
+		__mmask8 hi = _mm512_cmpgt_epi64_mask(lo, bm1);
+		lo = _mm512_mask_sub_epi64(lo, hi, lo, bv);
+		q = _mm512_mask_add_epi64(q, hi, q, one);
+		__mmask8 lt = _mm512_cmplt_epi64_mask(lo, zero);
+		lo = _mm512_mask_add_epi64(lo, lt, lo, bv);
+		q = _mm512_mask_sub_epi64(q, lt, q, one);
+
+		// lane j gets the quotient of lane j - 1, lane 0 the top one of the previous block
+		_mm512_storeu_si512(r + i, _mm512_add_epi64(lo, _mm512_mask_alignr_epi64(zero, all, q, prev, 7)));
+		prev = q;
+	}
+	ull top[8];
+	_mm512_storeu_si512(top, prev);
+	ull c = top[7] + carry_avx512(r, m);
+	return mul_small_scalar(r + m, x + m, n - m, k, c);
+}
+
+__attribute__((target("avx512f")))
+static int cmp_avx512(const ull* x, const ull* y, size_t n)
+{
+	size_t i = n;
+	for (; i >= 8; i -= 8) {
+		unsigned ne = _mm512_cmpneq_epu64_mask(_mm512_loadu_si512(x + i - 8), _mm512_loadu_si512(y + i - 8));
+		if (ne) {
+			size_t j = i - 8 + (31 - __builtin_clz(ne));
+			return x[j] < y[j] ? -1 : 1;
+		}
+	}
+	return cmp_scalar(x, y, i);
+}
+
+#endif // LIMB_KERNELS_X86
+
+#ifdef LIMB_KERNELS_NEON
+
+static inline uint64x2_t neon_bits(unsigned m)
+{
+	return vcombine_u64(vcreate_u64(m & 1), vcreate_u64((m >> 1) & 1));
+}
+
+static inline unsigned neon_mask(uint64x2_t v)
+{
+	return (unsigned)(vgetq_lane_u64(v, 0) & 1) | (unsigned)(vgetq_lane_u64(v, 1) & 2);
+}
+
+static ull add_neon(ull* r, const ull* x, const ull* y, size_t n)
+{
+	const uint64x2_t bm1 = vdupq_n_u64(limb_base - 1);
+	const uint64x2_t bv = vdupq_n_u64(limb_base);
+	unsigned c = 0;
+	size_t i = 0;
+	for (; i + 2 <= n; i += 2) {
+		uint64x2_t s = vaddq_u64(vld1q_u64((const uint64_t*)(x + i)), vld1q_u64((const uint64_t*)(y + i)));
+		unsigned g = neon_mask(vcgtq_u64(s, bm1));
+		unsigned p = neon_mask(vceqq_u64(s, bm1));
+		unsigned t = (g | p) + g + c;
+		c = (t >> 2) & 1;
+		s = vaddq_u64(s, neon_bits(t ^ p));
+		s = vsubq_u64(s, vandq_u64(vcgtq_u64(s, bm1), bv));
+		vst1q_u64((uint64_t*)(r + i), s);
+	}
+	return add_scalar(r + i, x + i, y + i, n - i, c);
+}
+
+static ull sub_neon(ull* r, const ull* x, const ull* y, size_t n)
+{
+	const uint64x2_t bv = vdupq_n_u64(limb_base);
+	unsigned b = 0;
+	size_t i = 0;
+	for (; i + 2 <= n; i += 2) {
+		uint64x2_t xv = vld1q_u64((const uint64_t*)(x + i));
+		uint64x2_t yv = vld1q_u64((const uint64_t*)(y + i));
+		unsigned g = neon_mask(vcgtq_u64(yv, xv));
+		unsigned p = neon_mask(vceqq_u64(xv, yv));
+		unsigned t = (g | p) + g + b;
+		b = (t >> 2) & 1;
+		uint64x2_t d = vsubq_u64(vsubq_u64(xv, yv), neon_bits(t ^ p));
+		d = vaddq_u64(d, vandq_u64(vcltzq_s64(vreinterpretq_s64_u64(d)), bv));
+		vst1q_u64((uint64_t*)(r + i), d);
+	}
+	return sub_scalar(r + i, x + i, y + i, n - i, b);
+}
+
+// limbs below 2 * base brought under base, returns the carry
+static ull carry_neon(ull* r, size_t n)
+{
+	const uint64x2_t bm1 = vdupq_n_u64(limb_base - 1);
+	const uint64x2_t bv = vdupq_n_u64(limb_base);
+	unsigned c = 0;
+	for (size_t i = 0; i < n; i += 2) {
+		uint64x2_t s = vld1q_u64((const uint64_t*)(r + i));
+		unsigned g = neon_mask(vcgtq_u64(s, bm1));
+		unsigned p = neon_mask(vceqq_u64(s, bm1));
+		if ((g | c) == 0)
+			continue;
+		unsigned t = (g | p) + g + c;
+		c = (t >> 2) & 1;
+		s = vaddq_u64(s, neon_bits(t ^ p));
+		s = vsubq_u64(s, vandq_u64(vcgtq_u64(s, bm1), bv));
+		vst1q_u64((uint64_t*)(r + i), s);
+	}
+	return c;
+}
+
+// mul_small_avx2 two lanes wide: the products from vmull_u32, the quotients
+// through float64x2 with vrndmq for the floor, vextq to move them up a lane
+static ull mul_small_neon(ull* r, const ull* x, size_t n, ull k)
+{
+	if (k >= limb_base)
+		return mul_small_scalar(r, x, n, k, 0);
+
+	const uint32x2_t kv = vdup_n_u32((uint32_t)k);
+	const uint32x2_t b32 = vdup_n_u32((uint32_t)limb_base);
+	const int64x2_t bm1 = vdupq_n_s64(limb_base - 1);
+	const int64x2_t bv = vdupq_n_s64(limb_base);
+	const float64x2_t inv = vdupq_n_f64(1.0 / limb_base);
+	uint64x2_t prev = vdupq_n_u64(0);
+	size_t m = n & ~(size_t)1;
+	for (size_t i = 0; i < m; i += 2) {
+		uint64x2_t p = vmull_u32(vmovn_u64(vld1q_u64((const uint64_t*)(x + i))), kv);
+		uint64x2_t q = vcvtq_u64_f64(vrndmq_f64(vmulq_f64(vcvtq_f64_u64(p), inv)));
+		int64x2_t lo = vreinterpretq_s64_u64(vsubq_u64(p, vmull_u32(vmovn_u64(q), b32)));
+		// the masks are all ones, -1, where the quotient is a unit off
+		int64x2_t hi = vreinterpretq_s64_u64(vcgtq_s64(lo, bm1));
+		lo = vsubq_s64(lo, vandq_s64(hi, bv));
+		q = vreinterpretq_u64_s64(vsubq_s64(vreinterpretq_s64_u64(q), hi));
+		int64x2_t lt = vreinterpretq_s64_u64(vcltzq_s64(lo));
+		lo = vaddq_s64(lo, vandq_s64(lt, bv));
+		q = vreinterpretq_u64_s64(vaddq_s64(vreinterpretq_s64_u64(q), lt));
+
+		// lane 1 gets the quotient of lane 0, lane 0 the top one of the previous pair
+		vst1q_u64((uint64_t*)(r + i), vaddq_u64(vreinterpretq_u64_s64(lo), vextq_u64(prev, q, 1)));
+		prev = q;
+	}
+	ull c = vgetq_lane_u64(prev, 1) + carry_neon(r, m);
+	return mul_small_scalar(r + m, x + m, n - m, k, c);
+}
+
+static int cmp_neon(const ull* x, const ull* y, size_t n)
+{
+	size_t i = n;
+	for (; i >= 2; i -= 2) {
+		uint64x2_t eq = vceqq_u64(vld1q_u64((const uint64_t*)(x + i - 2)), vld1q_u64((const uint64_t*)(y + i - 2)));
+		if (neon_mask(eq) != 3)
+			return cmp_scalar(x + i - 2, y + i - 2, 2);
+	}
+	return cmp_scalar(x, y, i);
+}
+
+#endif // LIMB_KERNELS_NEON
+
+struct LimbKernels
+{
+	const char* isa;
+	ull (*add)(ull*, const ull*, const ull*, size_t);
+	ull (*sub)(ull*, const ull*, const ull*, size_t);
+	ull (*mul_small)(ull*, const ull*, size_t, ull);
+	int (*cmp)(const ull*, const ull*, size_t);
+	bool (*supported)();
+};
+
+static bool always() { return true; }
+
+static const LimbKernels kernel_sets[] = {
+#ifdef LIMB_KERNELS_X86
+	{ "avx512", add_avx512, sub_avx512, mul_small_avx512, cmp_avx512,
+		[] { return (bool)__builtin_cpu_supports("avx512f"); } },
+	{ "avx2", add_avx2, sub_avx2, mul_small_avx2, cmp_avx2,
+		[] { return (bool)__builtin_cpu_supports("avx2"); } },
+#endif
+#ifdef LIMB_KERNELS_NEON
+	{ "neon", add_neon, sub_neon, mul_small_neon, cmp_neon, always },
+#endif
+	{ "scalar", add_generic, sub_generic, mul_small_generic, cmp_scalar, always },
+};
+
+// the first supported set, best first
+static const LimbKernels*& active()
+{
+	static const LimbKernels* k = [] {
+		for (auto& s : kernel_sets)
+			if (s.supported())
+				return &s;
+		return &kernel_sets[0];
+	}();
+	return k;
+}
+
+ull limbs_add(ull* r, const ull* x, const ull* y, size_t n)
+{
+	if (n < simd_min)
+		return add_scalar(r, x, y, n, 0);
+	return active()->add(r, x, y, n);
+}
+
+ull limbs_sub(ull* r, const ull* x, const ull* y, size_t n)
+{
+	if (n < simd_min)
+		return sub_scalar(r, x, y, n, 0);
+	return active()->sub(r, x, y, n);
+}
+
+ull limbs_mul_small(ull* r, const ull* x, size_t n, ull k)
+{
+	if (n < simd_min)
+		return mul_small_scalar(r, x, n, k, 0);
+	return active()->mul_small(r, x, n, k);
+}
+
+int limbs_cmp(const ull* x, const ull* y, size_t n)
+{
+	if (n < simd_min)
+		return cmp_scalar(x, y, n);
+	return active()->cmp(x, y, n);
+}
+
+// Division by one word. Each step divides rem * base + limb, which stays
+// below 2^46 for divisors under 2^32, through the reciprocal instead of a
+// hardware division; the remainder alone takes two limbs per step.
+
+static inline ull mul_hi(ull a, ull b)
+{
+#ifdef __SIZEOF_INT128__
+	return (ull)(((unsigned __int128)a * b) >> 64);
+#else
+	ull al = a & 0xffffffff, ah = a >> 32, bl = b & 0xffffffff, bh = b >> 32;
+	ull mid = (al * bl >> 32) + (ah * bl & 0xffffffff) + al * bh;
+	return ah * bh + (ah * bl >> 32) + (mid >> 32);
+#endif
+}
+
+static inline ull div_step(ull c, const LimbDivisor& d, ull& r)
+{
+	ull q = mul_hi(c, d.inv);
+	r = c - q * d.d;
+	if (r >= d.d) {
+		r -= d.d;
+		++q;
+	}
+	return q;
+}
+
+// (r * base + v) mod d for d >= 2^32, where r * base can overflow
+static ull mod_step_wide(ull r, ull v, ull d)
+{
+#ifdef __SIZEOF_INT128__
+	return (ull)(((unsigned __int128)r * limb_base + v) % d);
+#else
+	auto add = [d](ull x, ull y) { return x >= d - y ? x - (d - y) : x + y; };
+	ull s = v % d;
+	for (ull k = limb_base; k != 0; k >>= 1, r = add(r, r))
+		if (k & 1)
+			s = add(s, r);
+	return s;
+#endif
+}
+
+ull limbs_div_small(ull* q, const ull* x, size_t n, const LimbDivisor& d)
+{
+	ull r = 0;
+	while (n-- > 0)
+		q[n] = div_step(r * limb_base + x[n], d, r);
+	return r;
+}
+
+ull limbs_mod_small(const ull* x, size_t n, ull d)
+{
+	ull r = 0;
+	if (d >> 32) {
+		while (n-- > 0)
+			r = mod_step_wide(r, x[n], d);
+		return r;
+	}
+
+	LimbDivisor dv(d);
+	if (n & 1)
+		div_step(x[--n], dv, r);
+	for (; n > 0; n -= 2)
+		div_step((r * limb_base + x[n - 1]) * limb_base + x[n - 2], dv, r);
+	return r;
+}
+
+const char* limb_kernels_isa()
+{
+	return active()->isa;
+}
+
+bool limb_kernels_use(const char* isa)
+{
+	for (auto& s : kernel_sets)
+		if (std::strcmp(s.isa, isa) == 0 && s.supported()) {
+			active() = &s;
+			return true;
+		}
+	return false;
+}
@@ -1,83 +1,76 @@
 ﻿#include "core/long.h"
 #include "core/real.h"
+#include "core/limb_kernels.h"
 #include <fstream>
 #include <time.h>
 #include <stdexcept>
 
-std::ostream & operator<<(std::ostream & stream, Long b) {
-	stream << b.operator std::string();
+std::ostream & operator<<(std::ostream & stream, const Long& b) {
+	if (b < 0 && !b.is_zero())
+		stream.put('-');
+	b.write_digits(stream);
 	return stream;
 }
 
-inline std::string my_to_string(const ull& a, const int base)
+// one limb, zero-padded to the digits of base
+std::string my_to_string(const ull& a, const int base)
 {
-	std::string s = "";
-	auto b = base; 
-	auto sz = 0;
-	while (b != 1) {
-		b = b / 10;
+	size_t sz = 0;
+	for (auto b = base; b != 1; b /= 10)
 		++sz;
-	}
-
-	std::string q = std::to_string(a);
-	auto ssz = q.size();
-	while (static_cast<int>(ssz) != sz){
-		s += "0"; 
-		++ssz;
-	}
-    s += std::to_string(a);
 
+	std::string s = std::to_string(a);
+	if (s.size() < sz)
+		s.insert(0, sz - s.size(), '0');
 	return s;
 }
 
-const ull Long::base = 10000;
-const uint Long::bs = std::log10(Long::base);
+static_assert(Long::base == limb_base, "Long and the limb kernels must agree on the base");
 const ull Long::karacnaive = 25;
 const ull Long::toom3naive = 30;
 const ull Long::strasnaive = 40;
+const ull Long::nttnaive = 100;
 const char* Long::delim = ",";
 
-Long::Long() : sign(true) {}
+Long::Long() : sign(1) {}
 
 Long::~Long()
 {
 	clear();
 }
 
-Long::Long(const Long & other)
-{
-	operator=(other);
-}
+Long::Long(const Long & other) : sign(other.sign), a(other.a) {}
 
-Long::Long(Long && other)
+// the source is left empty; heap limbs change owner, inline ones are copied
+Long::Long(Long && other) noexcept : sign(other.sign), a(std::move(other.a))
 {
-	operator=(other);
+	other.clear();
 }
 
 Long & Long::operator=(const Long & other)
 {
-	clear();
 	a = other.a;
 	sign = other.sign;
 	return *this;
 }
 
-Long & Long::operator=(Long && other)
+Long & Long::operator=(Long && other) noexcept
 {
-	clear();
-	a = other.a;
-	sign = other.sign;
-	other.clear();
+	if (this != &other) {
+		a = std::move(other.a);
+		sign = other.sign;
+		other.clear();
+	}
 	return *this;
 }
 
 void Long::clear()
 {
-	sign = 0;
+	sign = 1;
 	a.clear();
 }
 
-const vector<ull>& Long::container() const {
+const limb_vector& Long::container() const {
 	return a;
 }
 
@@ -121,6 +114,43 @@ void Long::print(std::ostream & stream) const
 	stream << "\n";
 }
 
+// The limbs are decimal already, so the digits come straight out of them,
+// top limb first: memory stays at one buffer however long the number is.
+void Long::write_digits(std::ostream & stream, uint point, char delim) const
+{
+	static const ull pw[] = { 1, 10, 100, 1000 };
+	char buf[1 << 14];
+	size_t n = 0;
+	auto put = [&](char c) {
+		if (n == sizeof buf) {
+			stream.write(buf, n);
+			n = 0;
+		}
+		buf[n++] = c;
+	};
+
+	ull left = is_zero() ? 1 : real_size(); // digits not written yet
+	if (point >= left) {
+		put('0');
+		put(delim);
+		for (ull i = left; i < point; ++i)
+			put('0');
+		point = 0;
+	}
+	for (int i = size() - 1; i >= 0; --i) {
+		int d = bs - 1;
+		if (i == static_cast<int>(size()) - 1)
+			while (d > 0 && a[i] < pw[d])
+				--d;
+		for (; d >= 0; --d, --left) {
+			if (left == point)
+				put(delim);
+			put(static_cast<char>('0' + a[i] / pw[d] % 10));
+		}
+	}
+	stream.write(buf, n);
+}
+
 Long::operator std::string() const
 {
 	if (size() == 1 && a[0] == 0){
@@ -128,7 +158,7 @@ Long::operator std::string() const
 	}
 
 	std::string s = "";
-	if (!sign) s += "-";
+	if (sign != 1) s += "-";
 
 	int i = size() - 1;
 	s += std::to_string(a[i--]);
@@ -140,7 +170,7 @@ Long::operator std::string() const
 
 ull Long::set(uint i, ull v) {
 	if (i >= size()) {
-		insert(vector<ull>(i + 1 - size(), 0));
+		a.resize(i + 1, 0);
 	}
 	a[i] = v;
 	return v;
@@ -151,23 +181,26 @@ void Long::insert(ull v)
 	a.push_back(v);
 }
 
-Long Long::insert(vector<ull> x)
+Long& Long::insert(const vector<ull>& x)
 {
 	a.insert(a.cbegin(), x.cbegin(), x.cend());
 	return *this;
 }
 
-Long Long::shift(uint n)
+Long& Long::insert(const limb_vector& x)
 {
-	if (n > 3)
-		return insert(vector<ull>(n, (ull)0));
-	while (n-- > 0) {
-		a.emplace(a.begin(), (ull)0);
-	}
+	a.insert(a.cbegin(), x.cbegin(), x.cend());
+	return *this;
+}
+
+// the limbs keep free room in front, so this is O(n) and not O(size)
+Long& Long::shift(uint n)
+{
+	a.insert(a.begin(), n, (ull)0);
 	return *this;
 }
 
-Long Long::shiftaccurate(uint n)
+Long& Long::shiftaccurate(uint n)
 {
 	while (n > bs) {
 		shift(1); 
@@ -180,7 +213,7 @@ Long Long::shiftaccurate(uint n)
 	return normal();
 }
 
-Long Long::shiftback(uint n)
+Long& Long::shiftback(uint n)
 {
 	while (n > bs) {
 		shift(1); 
@@ -191,7 +224,7 @@ Long Long::shiftback(uint n)
 	return normal();
 }
 
-Long Long::changeSign(int b)
+Long& Long::changeSign(int b)
 {
 	if (b == 1) sign = 1;
 	else if (b == -1) sign = -1;
@@ -201,7 +234,7 @@ Long Long::changeSign(int b)
 	return *this;
 }
 
-Long Long::normal()
+Long& Long::normal()
 {
 	ull tmp = 0;
 	for (uint i = 0; i < size(); ++i) {
@@ -229,6 +262,55 @@ Long Long::normal()
 	return *this;
 }
 
+// Takes the limbs of a lazily evaluated sum (see long_expr.h): one signed
+// carry pass, then the magnitude is negated if the top carry came out
+// negative.
+Long& Long::normal_signed(signed_limbs& acc)
+{
+	const long long b = (long long)base;
+	long long carry = 0;
+	for (auto& v : acc) {
+		v += carry;
+		carry = v / b;
+		v %= b;
+		if (v < 0) {
+			v += b;
+			--carry;
+		}
+	}
+
+	sign = 1;
+	if (carry < 0) {
+		sign = -1;
+		carry = -carry;
+		long long borrow = 0;
+		for (auto& v : acc) {
+			v = -v - borrow;
+			borrow = 0;
+			if (v < 0) {
+				v += b;
+				borrow = 1;
+			}
+		}
+		carry -= borrow;
+	}
+
+	a.resize(acc.size());
+	for (uint i = 0; i < acc.size(); ++i)
+		a[i] = (ull)acc[i];
+	while (carry > 0) {
+		a.push_back((ull)(carry % b));
+		carry /= b;
+	}
+	if (a.empty())
+		a.push_back(0);
+	while (a.size() > 1 && a.back() == 0)
+		a.pop_back();
+	if (a.size() == 1 && a[0] == 0)
+		sign = 1;
+	return *this;
+}
+
 // Constructors
 Long::Long(uint v)
 {
@@ -271,40 +353,40 @@ Long::Long(const vector<ull>& x)
 }
 
 // Assignment operators
-Long Long::operator=(uint v)
+Long& Long::operator=(uint v)
 {
 	return operator=((ull)v);
 }
 
-Long Long::operator=(unsigned long v)
+Long& Long::operator=(unsigned long v)
 {
 	return set((ull)(v));
 }
 
-Long Long::operator=(int v)
+Long& Long::operator=(int v)
 {
 	return set((ull)(::abs(v)), v >= 0);
 }
 
-Long Long::operator=(long v)
+Long& Long::operator=(long v)
 {
 	return set((ull)(::abs(v)), v >= 0);
 }
 
-Long Long::operator=(long long v)
+Long& Long::operator=(long long v)
 {
 	return set((ull)(::abs(v)) , v >= 0);
 }
 
-Long Long::operator=(ull v)
+Long& Long::operator=(ull v)
 {
 	return set(v);
 }
 
-Long Long::set(ull v, bool s)
+Long& Long::set(ull v, bool s)
 {
 	clear();
-	sign = s;
+	sign = s ? 1 : -1;
 	if (v == 0)
 	{
 		a.push_back(v);
@@ -320,14 +402,14 @@ Long Long::set(ull v, bool s)
 	return *this;
 }
 
-Long Long::operator=(const char* v)
+Long& Long::operator=(const char* v)
 {
 	clear();
 	ull e = 0; 
 	uint size = 0;
 	while (*(v++)) ++size;
 	if (size == 0)
-		return null;
+		return set(0);
 
 	auto b = 1;
 
@@ -335,15 +417,15 @@ Long Long::operator=(const char* v)
 	
 	auto lb = 0;
 	if (v[0] == '-') {
-		sign = false;
+		sign = -1;
 		lb = 1;
 	}
 	else if (v[0] == '+') {
-		sign = true;
+		sign = 1;
 		lb = 1;
 	}
 	else {
-		sign = true;
+		sign = 1;
 		lb = 0;
 	}
 	v += lb;
@@ -360,21 +442,41 @@ Long Long::operator=(const char* v)
 			b = 1;
 		}
 	}
-	if(e != 0)
+	if(e != 0 || a.empty())
 		insert(e);
 
 	return *this;
 }
 
-Long Long::operator=(const vector<ull>& x)
+Long& Long::operator=(const vector<ull>& x)
 {
 	clear();
 	insert(x);
-	sign = true;
+	sign = 1;
 	return *this;
 }
 
+// used by the _L literals, whose limbs are computed at compile time
+Long Long::from_limbs(const ull* limbs, uint n, bool negative)
+{
+	Long c;
+	c.a.insert(c.a.end(), limbs, limbs + n);
+	while (c.a.size() > 1 && c.a.back() == 0)
+		c.a.pop_back();
+	if (c.a.empty())
+		c.a.push_back(0);
+	c.sign = negative ? -1 : 1;
+	return c;
+}
+
 // Arithmetic operators
+Long Long::operator-() const
+{
+	Long c = *this;
+	c.changeSign();
+	return c;
+}
+
 Long Long::operator+(const Long & other) const
 {
 	return sum(other);
@@ -389,32 +491,38 @@ Long Long::operator*(const Long & other) const
 {
 	if (size() == 0 || other.size() == 0)
 		return null;
-	else if (other == mone) {
-		auto t = *this;
-		return t.changeSign();
-	}
-	else if (other == null) {
-		return null;
-	}
-	else if (other == pone) {
+	else if (other.size() == 1 && other.a[0] <= 1) { // 0, 1 or -1
+		if (other.a[0] == 0)
+			return null;
 		auto t = *this;
+		t.changeSign(sign * other.sign);
 		return t;
 	}
 	else if (size() == 1 && other.size() == 1) {
-		return Long(a[0] * other[0]).changeSign(sign * other.sign);
+		Long c(a[0] * other[0]);
+		c.changeSign(sign * other.sign);
+		return c;
+	}
+	else if (size() == 1 || other.size() == 1) {
+		Long c = (other.size() == 1) ? mul_limb(other.a[0]) : other.mul_limb(a[0]);
+		c.changeSign(sign * other.sign);
+		return c;
 	}
 	else if (size() < karacnaive || other.size() < karacnaive)
 		return mul(other);
 	else if (size() < toom3naive || other.size() < toom3naive)
 		return karac_mul(other);
-	else
+	else if (size() < nttnaive || other.size() < nttnaive)
 		return strassen_mul(other);
+	else
+		return ntt_mul(other); // exact where the double FFT is not, and faster
 }
 
 Long Long::operator/(const int other) const
 {
-	Long rem;
-	return divide(other, rem);
+	Long r = *this;
+	r /= other;
+	return r;
 }
 
 Long Long::operator/(const Long & other) const {
@@ -428,83 +536,128 @@ Long Long::operator%(const Long & other) const {
 	return rem;
 }
 
+// Compound assignment: magnitudes of equal sign are added in place,
+// everything else goes through the binary operator and a move.
+Long& Long::operator+=(const Long & other)
+{
+	if (sign != other.sign)
+		return *this = sum(other);
+	return add_abs(other);
+}
+
+Long& Long::operator-=(const Long & other)
+{
+	if (sign == other.sign)
+		return *this = neg(other);
+	return add_abs(other);
+}
+
+Long& Long::operator*=(const Long & other)
+{
+	return *this = operator*(other);
+}
+
+Long& Long::operator/=(const int other)
+{
+	if (other == 0 || size() == 0)
+		throw std::runtime_error("Division by zero!");
+	div_abs_small(other < 0 ? -(ull)other : (ull)other);
+	if (other < 0)
+		changeSign();
+	return *this;
+}
+
+Long& Long::operator/=(const Long & other)
+{
+	return *this = operator/(other);
+}
+
+Long& Long::operator%=(const Long & other)
+{
+	return *this = operator%(other);
+}
+
 // Comparison operators
-bool Long::operator==(const Long & other) const
+// -1, 0, 1 as |this| is below, equal to or above |b|
+int Long::compare_abs(const Long& b) const
+{
+	uint n = size(), m = b.size();
+	while (n > 0 && a[n - 1] == 0) --n; // zero or not normalized yet
+	while (m > 0 && b.a[m - 1] == 0) --m;
+	if (n != m)
+		return n < m ? -1 : 1;
+	return limbs_cmp(a.data(), b.a.data(), n);
+}
+
+int Long::compare(const Long& b) const
 {
-	if (size() == 1 && other.size() == 1 && a[0] == 0 && other[0] == 0)
-		return true;
-	if (sign != other.sign) return false;
-	else if (size() != other.size()) return false;
-	for (int i = 0; i < static_cast<int>(size()); ++i) {
-		if (a[i] != other[i]) return false;
+	if (sign != b.sign) {
+		if (is_zero() && b.is_zero())
+			return 0;
+		return sign < b.sign ? -1 : 1;
 	}
+	int c = compare_abs(b);
+	return sign == 1 ? c : -c;
+}
+
+bool Long::is_zero() const
+{
+	for (uint i = size(); i > 0; --i)
+		if (a[i - 1] != 0)
+			return false;
 	return true;
 }
 
+bool Long::operator==(const Long & other) const
+{
+	return compare(other) == 0;
+}
+
 bool Long::operator!=(const Long & other) const
 {
-	return !operator==(other);
+	return compare(other) != 0;
 }
 
 bool Long::operator<(const Long & other) const
 {
-	if (sign < other.sign) return true;
-	else if (size() < other.size()) return true;
-	else if (size() == other.size()) {
-		for (int i = size() - 1; i >= 0; --i) {
-			if (a[i] > other[i]) return false;
-			else if (a[i] < other[i]) return true;
-		}
-		return false;
-	}
-	else return false;
+	return compare(other) < 0;
 }
 
 bool Long::operator>(const Long & other) const
 {
-	if (sign > other.sign) return true;
-	else if (size() > other.size())
-		return true;
-	else if (size() == other.size()) {
-		for (int i = size() - 1; i >= 0; --i) {
-			if (a[i] < other[i]) return false;
-			else if (a[i] > other[i]) return true;
-		}
-		return false;
-	}
-	else return false;
+	return compare(other) > 0;
 }
 
 bool Long::operator<=(const Long & other) const
 {
-	if (sign < other.sign) return true;
-	else if (size() < other.size()) return true;
-	else if (size() == other.size()) {
-		for (int i = size() - 1; i >= 0; --i) {
-			if (a[i] > other[i]) return false;
-			else if (a[i] < other[i]) return true;
-		}
-		return true;
-	}
-	else return false;
+	return compare(other) <= 0;
 }
 
 bool Long::operator>=(const Long & other) const
 {
-	if (sign > other.sign) return true;
-	else if (size() > other.size())
-		return true;
-	else if (size() == other.size()) {
-		for (int i = size() - 1; i >= 0; --i) {
-			if (a[i] < other[i]) return false;
-		else if (a[i] > other[i]) return true;
-		}
-		return true;
-	}
-	else return false;
+	return compare(other) >= 0;
 }
 
 // Arithmetic operations
+
+// |this| += |b|
+Long& Long::add_abs(const Long& b)
+{
+	uint n = b.size();
+	if (n > size())
+		a.resize(n, 0);
+	ull carry = limbs_add(a.data(), a.data(), b.a.data(), n);
+	uint i = n;
+	for (; carry && i < size(); ++i) {
+		ull v = a[i] + 1;
+		carry = v >= base;
+		a[i] = carry ? 0 : v;
+	}
+	if (carry)
+		a.push_back(1);
+	return *this;
+}
+
 Long Long::sum(const Long& b) const
 {
 	int fl = b.sign;
@@ -523,12 +676,8 @@ Long Long::sum(const Long& b) const
 		return b.sum(*this);
 
 	Long c = *this;
-	c.a.resize(c.size() + 1);
-	for (uint i = 0; i < size(); ++i) {
-		c.a[i] += b[i];
-	}
-
-	return c.normal().changeSign(fl);
+	c.add_abs(b);
+	return c;
 }
 
 Long Long::neg(const Long & b) const
@@ -539,48 +688,53 @@ Long Long::neg(const Long & b) const
 		return sum(l.changeSign());
 	}
 
-	if (b.operator>(*this)) {
-		return (b.neg(*this)).changeSign(false);
+	if (b.compare_abs(*this) > 0) {
+		Long c = b.neg(*this);
+		c.changeSign(false);
+		return c;
 	}
 
 	Long c = *this;
-	bool tmp = 0;
-
-	for (uint i = 0; i < size(); ++i) {
-		if (tmp) {
-			if (c.a[i] > 0) {
-				c.a[i] = c.a[i] - 1;
-				tmp = false;
-			}
-			else {
-				c.a[i] = base - 1;
-				tmp = true;
-			}
-		}
+	c.sub_abs(b);
+	return c;
+}
 
-		if (c.a[i] >= b[i])
-			c.a[i] = (c.a[i] - b[i]);
-		else if (i + 1 < size()) {
-			c.a[i] = (base + c.a[i] - b[i]);
-			tmp = true;
-		}
-		else {
-#ifdef DEBUG
-			std::cout << *this << " >= " << b << "\n";
-			std::cout << c.a[i] << " >= " << b[i] << "\n";
-#endif // DEBUG
+Long& Long::sub_abs(const Long& b)
+{
+	if (b.size() > size())
+		throw std::logic_error("bye from minus ver2");
 
-			throw std::logic_error("bye from minus ver2");
-		}
+	ull borrow = limbs_sub(a.data(), a.data(), b.a.data(), b.size());
+	for (uint i = b.size(); borrow && i < size(); ++i) {
+		borrow = a[i] == 0;
+		a[i] = borrow ? base - 1 : a[i] - 1;
 	}
+	if (borrow)
+		throw std::logic_error("bye from minus ver2");
 
-	return c.normal();
+	while (a.size() > 1 && a.back() == 0)
+		a.pop_back();
+	return *this;
 }
 
 // Binary search template for division
 template <class T>
 T binsearch(const Long& a, const Long& b, Long& pr, const T& _l, const T& _r);
 
+// |this| * k for one limb k
+Long Long::mul_limb(ull k) const
+{
+	Long c = *this;
+	ull carry = limbs_mul_small(c.a.data(), a.data(), size(), k);
+	while (carry != 0) {
+		c.a.push_back(carry % base);
+		carry /= base;
+	}
+	while (c.a.size() > 1 && c.a.back() == 0)
+		c.a.pop_back();
+	return c;
+}
+
 Long Long::mul(const Long& b) const
 {
 	int fl = (sign * b.sign);
@@ -588,12 +742,23 @@ Long Long::mul(const Long& b) const
 	int len = size() + b.size() - 1;
 	if (len <= 0) return null;
 
-	tmp.insert(vector<ull>(len, 0));
+	tmp.a.resize(len, 0);
 	for (uint i = 0; i < size(); ++i)
 		for (uint j = 0; j < b.size(); ++j)
 			tmp.a[i + j] += a[i] * b[j];
 
-	return tmp.normal().changeSign(fl);
+	tmp.normal().changeSign(fl);
+	return tmp;
+}
+
+// one-word divisors go through limbs_div_small, which multiplies by a
+// precomputed reciprocal instead of dividing every limb
+ull Long::div_abs_small(ull d)
+{
+	ull r = limbs_div_small(a.data(), a.data(), size(), LimbDivisor(d));
+	while (a.size() > 1 && a.back() == 0)
+		a.pop_back();
+	return r;
 }
 
 Long Long::divide(const int b, Long& rem) const
@@ -601,38 +766,48 @@ Long Long::divide(const int b, Long& rem) const
 	if (b == 0 || size() == 0)
 		throw std::runtime_error("Division by zero!");
 
-	auto t = b;
-	ull c = 0;
-	int fl = (sign);
-	if (b < 0) {
-		fl = (fl * 0);
-		t = ::abs(b);
-	}
-
 	Long r = *this;
-	for (int i = size() - 1; i >= 0; i--) {
-		c = a[i] + c * base;
-		r.set(i, c / t);
-		c = c % t;
+	rem = r.div_abs_small(b < 0 ? -(ull)b : (ull)b);
+	if (b < 0)
+		r.changeSign();
+	return r;
+}
+
+ull Long::mod_small(ull d) const
+{
+	if (d == 0)
+		throw std::runtime_error("Division by zero!");
+	return limbs_mod_small(a.data(), size(), d);
+}
+
+// |this| <= |b|, settled by one comparison of magnitudes: the quotient is
+// 0 or +-1 and the remainder |this| or 0, signed as in the long division
+static bool settle_division(const Long& x, const Long& b, Long& q, Long& rem)
+{
+	int c = x.compare_abs(b);
+	if (c > 0)
+		return false;
+	if (c < 0) {
+		q = null;
+		rem = abs(x);
 	}
-	rem = c;
-	return r.normal().changeSign(fl);
+	else {
+		q = pone;
+		q.changeSign((x < 0) == (b < 0) ? 1 : -1);
+		rem = null;
+	}
+	return true;
 }
 
 Long Long::divide(const Long & b, Long& rem) const
 {
-	if (size() == 0 || b.size() == 0 || b == 0)
+	if (size() == 0 || b.size() == 0 || b.is_zero())
 		throw std::runtime_error("Division by zero!");
-	else if ((size() == 1 && a[0] == 0))
-		return 0;
-	else if (size() < b.size() || *this < b) {
-		rem = *this;
-		return null;
-	}
-	else if (*this == b)
-		return pone;
+	Long q = null;
+	if (settle_division(*this, b, q, rem))
+		return q;
 	else if (b.size() == 1) 
-		return divide((int)b[0], rem);
+		return divide(b.sign == 1 ? (int)b[0] : -(int)b[0], rem);
 
 	auto t = b;
 	int fl = (sign);
@@ -647,15 +822,15 @@ Long Long::divide(const Long & b, Long& rem) const
 		c.shift(); 
 		c.set(0, a[i]);
 		ull tmp = 0;
-		if (c.size() >= b.size() && (c >= b)) {
-			if (c == b) {
+		if (c.size() >= t.size() && (c >= t)) {
+			if (c == t) {
 				c.clear();
 				r.set(i, (ull)1);
 			}
 			else {
 				auto pr = null;
-				auto mid = binsearch<ull>(c, b, pr, 0, base);
-				c = c - pr;
+				auto mid = binsearch<ull>(c, t, pr, 0, base);
+				c.sub_abs(pr); // in place, c keeps its front room for the next shift
 				if (c == null) 
 					c.clear();
 
@@ -665,8 +840,11 @@ Long Long::divide(const Long & b, Long& rem) const
 		else
 			r.set(i, tmp);
 	}
+	if (c.size() == 0)   // exact division
+		c = null;
 	rem = c.normal();
-	return r.normal().changeSign(fl);
+	r.normal().changeSign(fl);
+	return r;
 }
 
 template <class T>
@@ -692,18 +870,13 @@ T binsearch(const Long& a, const Long& b, Long& pr, const T& _l, const T& _r) {
 
 Long Long::divide2(const Long & b, Long& rem) const
 {
-	if (size() == 0 || b.size() == 0 || b == 0)
+	if (size() == 0 || b.size() == 0 || b.is_zero())
 		throw std::runtime_error("Division by zero!");
-	else if ((size() == 1 && a[0] == 0))
-		return 0;
-	else if (size() < b.size() || *this < b) {
-		rem = *this;
-		return null;
-	}
-	else if (*this == b)
-		return pone;
+	Long q = null;
+	if (settle_division(*this, b, q, rem))
+		return q;
 	else if (b.size() == 1)
-		return divide((int)b[0], rem);
+		return divide(b.sign == 1 ? (int)b[0] : -(int)b[0], rem);
 
 	auto t = b;
 	int fl = (sign);
@@ -712,14 +885,20 @@ Long Long::divide2(const Long & b, Long& rem) const
 		t.changeSign();
 	}
 
-	Long r, c;
-	r = binsearch(*this, b, c, null, *this);
-	c = *this - r;
-	if (c == null)
-		c.clear();
-
+	Long x = abs(*this), pr = null;
+	Long r = binsearch(x, t, pr, null, x);
+	Long c = x - pr;
+	while (c < 0) {  // the search may stop one off either way
+		r -= pone;
+		c += t;
+	}
+	while (c >= t) {
+		r += pone;
+		c -= t;
+	}
 	rem = c.normal();
-	return r.normal().changeSign(fl);
+	r.normal().changeSign(fl);
+	return r;
 }
 
 Long Long::mult_inv(const Long& b) const
@@ -772,22 +951,47 @@ Long Long::karac_mul(const Long & b) const
 	Long xlyl = xl.karac_mul(yl);
 	Long xryr = xr.karac_mul(yr);
 
-	return (Long().insert(xlyl.a).insert(vector<ull>(2 * k, 0)) + xryr 
-		+ ((xl + xr).karac_mul(yl + yr) - (xlyl + xryr)).insert(vector<ull>(k, 0))).changeSign(fl);
+	Long mid = Long(lazy(xl) + xr).karac_mul(lazy(yl) + yr);
+	Long c = lazy(xlyl).shift(2 * k) + xryr + (lazy(mid) - xlyl - xryr).shift(k);
+	c.changeSign(fl);
+	return c;
 }
 
-Real inverse(const Long& a, uint iterations) {
-	auto rs = a.real_size() + 1;
-	Real approx(Long((ull)std::pow(10, (rs > Long::bs) ? Long::bs - rs % Long::bs : rs)), rs);
+// Newton's x = x (2 - a x), started from the reciprocal of the top digits.
+// Every step doubles the correct digits, so x keeps only that many limbs
+// (and its products are short ones) until it has the limbs asked for.
+static Real newton_inverse(const Long& a, uint limbs, uint iterations) {
+	if (a.is_zero())
+		throw std::runtime_error("Division by zero!");
+
+	// |a| ~ t * 10^(rs - dt) with t the top limbs, dt digits of them: five
+	// limbs, as the first may hold a single digit and the start needs 15
+	uint rs = a.real_size(), n = a.size(), top = std::min(n, 5u);
+	long double t = 0;
+	for (uint i = 0; i < top; ++i)
+		t = t * Long::base + a[n - 1 - i];
+	uint dt = rs - (n - top) * Long::bs;
+	ull q = (ull)(std::pow(10.0L, (long double)(dt + 15)) / t); // 10^15 < q <= 10^16
+
+	Real approx(Long(q), rs + 15);
 	const Real two = Real(Long(2), 0);
-	const Real th = Real(a, 0);
-	
-	for (uint i = 0, count = 0; i < iterations; ++i, ++count) {
+	const Real th = Real(abs(a), 0);
+	for (uint i = 0, good = 14; i < iterations && good < (limbs + 1) * Long::bs; ++i) {
+		good *= 2;
+		approx.set_prec(std::min(good / Long::bs, limbs) + 2);
 		approx = approx * (two - approx * th);
-		if (count == 6) {
-			count = 0;
-			approx.cut(rs + 5);
-		}
 	}
-	return approx.cut();
+	approx.set_prec(0);
+	approx.cut(limbs);
+	if (a < 0)
+		approx.changeSign();
+	return approx;
+}
+
+Real inverse(const Long& a, uint iterations) {
+	return newton_inverse(a, 16, iterations);
+}
+
+Real reciprocal(const Long& a, uint limbs) {
+	return newton_inverse(a, limbs, ~0u);
 }
\ No newline at end of file
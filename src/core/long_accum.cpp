@@ -0,0 +1,85 @@
+#include "core/long_accum.h"
+#include <stdexcept>
+
+LongAccumulator::LongAccumulator() : pending(0) {}
+
+LongAccumulator::LongAccumulator(const Long& x) : pending(0)
+{
+	add(x);
+}
+
+void LongAccumulator::reserve_weight(ull w)
+{
+	if (w > max_weight)
+		throw std::invalid_argument("LongAccumulator: coefficient too large");
+	if (pending + w > max_weight)
+		normalize();
+	pending += w;
+}
+
+LongAccumulator& LongAccumulator::add(const Long& x, long long k, uint shift)
+{
+	reserve_weight((ull)(k < 0 ? -k : k));
+	uint n = x.size();
+	if (acc.size() < n + shift)
+		acc.resize(n + shift, 0);
+
+	if (x.sign != 1)
+		k = -k;
+	long long* d = acc.data() + shift;
+	const ull* s = x.a.data();
+	if (k == 1)
+		for (uint i = 0; i < n; ++i)
+			d[i] += (long long)s[i];
+	else if (k == -1)
+		for (uint i = 0; i < n; ++i)
+			d[i] -= (long long)s[i];
+	else
+		for (uint i = 0; i < n; ++i)
+			d[i] += k * (long long)s[i];
+	return *this;
+}
+
+// leaves every limb in [0, base) except the top one, which keeps the sign
+void LongAccumulator::normalize()
+{
+	const long long b = (long long)Long::base;
+	long long carry = 0;
+	for (auto& v : acc) {
+		v += carry;
+		carry = v / b;
+		v %= b;
+		if (v < 0) {
+			v += b;
+			--carry;
+		}
+	}
+	while (carry >= b || carry <= -b) {
+		long long r = carry % b;
+		carry /= b;
+		if (r < 0) {
+			r += b;
+			--carry;
+		}
+		acc.push_back(r);
+	}
+	if (carry != 0)
+		acc.push_back(carry);
+	while (acc.size() > 1 && acc.back() == 0)
+		acc.pop_back();
+	pending = 1;
+}
+
+void LongAccumulator::clear()
+{
+	acc.clear();
+	pending = 0;
+}
+
+Long LongAccumulator::value() const
+{
+	signed_limbs t = acc;
+	Long r = null;
+	r.normal_signed(t);
+	return r;
+}
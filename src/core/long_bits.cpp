@@ -0,0 +1,327 @@
+#include "core/long.h"
+
+// Limbs are decimal (base 10^4), so bit operations are done with passes that
+// multiply or divide the limbs by a power of two. base^16 == 10^64 is
+// divisible by 2^64, hence the low 16 limbs alone define x mod 2^64.
+// Long shifts trade the passes, O(n) each, for one product: x << k is
+// x * 2^k, and x >> k is x * 5^k with k decimal digits dropped.
+
+static const uint shift_chunk = 48; // limb * 2^48 and carry * base stay below 2^62
+
+// v = v * m + c, m <= 2^48
+static void mul_add(limb_vector& v, ull m, ull c)
+{
+	for (auto& x : v) {
+		c += x * m;
+		x = c % Long::base;
+		c /= Long::base;
+	}
+	while (c != 0) {
+		v.push_back(c % Long::base);
+		c /= Long::base;
+	}
+}
+
+// v = v / 2^s, returns v mod 2^s; s <= 48
+static ull div_pow2(limb_vector& v, uint s)
+{
+	ull c = 0;
+	for (int i = v.size() - 1; i >= 0; --i) {
+		c = c * Long::base + v[i];
+		v[i] = c >> s;
+		c &= (1ull << s) - 1;
+	}
+	while (v.size() > 1 && v.back() == 0)
+		v.pop_back();
+	return c;
+}
+
+static bool zero_limbs(const limb_vector& v)
+{
+	return v.empty() || (v.size() == 1 && v[0] == 0);
+}
+
+// The magnitude as 64-bit words, lowest first, peeled off a copy of the limbs
+// 48 bits (one division pass) at a time. Each pass is linear in the limbs
+// left, so reading every word is quadratic; stopping early is cheaper.
+class WordStream
+{
+	limb_vector v;
+	unsigned __int128 buf = 0; // bits divided off v but not handed out yet
+	uint bits = 0;
+public:
+	explicit WordStream(const limb_vector& a) : v(a) {}
+
+	// the remaining words are all zero
+	bool done() const { return buf == 0 && zero_limbs(v); }
+
+	ull next()
+	{
+		while (bits < 64 && !zero_limbs(v)) {
+			buf |= (unsigned __int128)div_pow2(v, shift_chunk) << bits;
+			bits += shift_chunk;
+		}
+		ull w = (ull)buf;
+		buf >>= 64;
+		bits = (bits > 64) ? bits - 64 : 0;
+		return w;
+	}
+};
+
+ull Long::low_bits() const
+{
+	static const auto pw = [] {
+		vector<ull> p(16, 1);
+		for (uint i = 1; i < p.size(); ++i)
+			p[i] = p[i - 1] * base;
+		return p;
+	}();
+	ull r = 0;
+	for (uint i = 0; i < size() && i < pw.size(); ++i)
+		r += a[i] * pw[i];
+	return r;
+}
+
+// past this many bits a shift is one product instead of n / 48 passes
+static const uint product_shift_bits = 48 * 128;
+
+// b^k for b = 2 or 5; the last few are kept per thread, as the shifts of
+// to_words and of a rounding loop come back to the same k
+static const Long& power(ull b, uint k)
+{
+	struct Entry
+	{
+		ull b;
+		uint k;
+		Long p;
+		ull used;
+	};
+	thread_local vector<Entry> cache;
+	thread_local ull clock = 0;
+	++clock;
+	for (auto& e : cache)
+		if (e.b == b && e.k == k) {
+			e.used = clock;
+			return e.p;
+		}
+
+	Long p = pone;
+	for (int i = 31 - __builtin_clz(k); i >= 0; --i) {
+		p = p * p;
+		if ((k >> i) & 1)
+			p = p.mul_limb(b);
+	}
+	if (cache.size() < 16) {
+		cache.push_back({ b, k, std::move(p), clock });
+		return cache.back().p;
+	}
+	auto lru = std::min_element(cache.begin(), cache.end(), [](const Entry& x, const Entry& y) { return x.used < y.used; });
+	*lru = { b, k, std::move(p), clock };
+	return lru->p;
+}
+
+Long Long::operator<<(uint n) const
+{
+	if (n >= product_shift_bits && !zero_limbs(a))
+		return *this * power(2, n);
+
+	Long c = *this;
+	while (n > 0 && !zero_limbs(c.a)) {
+		auto s = std::min(n, shift_chunk);
+		mul_add(c.a, 1ull << s, 0);
+		n -= s;
+	}
+	return c;
+}
+
+Long Long::operator>>(uint n) const
+{
+	bool inexact = false;
+	return shift_right(n, inexact);
+}
+
+// floor(|x| * 5^n / 10^n): the low n / bs limbs of the product are dropped
+// whole, the last n % bs digits by one small division
+static Long shift_right_product(const Long& x, uint n, bool& inexact)
+{
+	static const ull pw[] = { 1, 10, 100, 1000 };
+	Long y = abs(x) * power(5, n);
+	uint drop = n / Long::bs;
+	const auto& v = y.container();
+	for (uint i = 0; i < drop && i < v.size() && !inexact; ++i)
+		inexact = v[i] != 0;
+	if (drop >= y.size())
+		return null;
+	Long r = Long::from_limbs(v.data() + drop, y.size() - drop, x < 0);
+	if (n % Long::bs) {
+		Long rem = null;
+		r = r.divide((int)pw[n % Long::bs], rem);
+		if (!rem.is_zero())
+			inexact = true;
+	}
+	return r;
+}
+
+Long Long::shift_right(uint n, bool& inexact) const
+{
+	if (n >= product_shift_bits && !zero_limbs(a)) {
+		if (n >= bit_length()) {
+			inexact = true;
+			return null;
+		}
+		return shift_right_product(*this, n, inexact);
+	}
+
+	Long c = *this;
+	while (n > 0 && !zero_limbs(c.a)) {
+		auto s = std::min(n, shift_chunk);
+		if (div_pow2(c.a, s) != 0)
+			inexact = true;
+		n -= s;
+	}
+	return c;
+}
+
+// below this many words the conversions run their passes; above it they
+// split at 2^(64 h), h a power of two, and the two halves recurse
+static const uint split_words = 256;
+
+// the words of x >= 0 appended to w, padded with zeros to at least pad words
+static void append_words(const Long& x, vector<ull>& w, size_t pad)
+{
+	size_t at = w.size();
+	uint limbs = x.size();
+	if (limbs < split_words * 5) { // 5 limbs hold 66 bits
+		WordStream s(x.container());
+		while (!s.done())
+			w.push_back(s.next());
+	}
+	else {
+		uint h = 1;
+		while (h * 5 * 2 < limbs)  // h words, near half of x
+			h *= 2;
+		Long hi = x >> (64 * h);
+		append_words(x - (hi << (64 * h)), w, h);
+		append_words(hi, w, 0);
+	}
+	if (w.size() < at + pad)
+		w.resize(at + pad, 0);
+}
+
+vector<ull> Long::to_words() const
+{
+	vector<ull> w;
+	append_words(abs(*this), w, 0);
+	while (!w.empty() && w.back() == 0)
+		w.pop_back();
+	return w;
+}
+
+Long Long::from_words(const vector<ull>& w)
+{
+	if (w.size() > split_words) {
+		size_t h = 1;
+		while (h * 2 < w.size())
+			h *= 2;
+		vector<ull> lo(w.begin(), w.begin() + h), hi(w.begin() + h, w.end());
+		return (from_words(hi) << (64 * h)) + from_words(lo);
+	}
+	Long c((ull)0);
+	for (int i = w.size() - 1; i >= 0; --i) {
+		mul_add(c.a, 1ull << 32, w[i] >> 32);
+		mul_add(c.a, 1ull << 32, w[i] & 0xffffffffull);
+	}
+	while (c.a.size() > 1 && c.a.back() == 0)
+		c.a.pop_back();
+	return c;
+}
+
+uint Long::bit_length() const
+{
+	if (zero_limbs(a))
+		return 0;
+
+	// the top limbs give log2 up to a tiny error, exact check only near a power of two
+	uint k = std::min(size(), 4u);
+	ull t = 0;
+	for (uint i = 0; i < k; ++i)
+		t = t * base + a[size() - 1 - i];
+	if (k == size())
+		return 64 - __builtin_clzll(t);
+
+	long double m = (size() - k) * bs * std::log2((long double)10);
+	long double lo = std::log2((long double)t) + m;
+	long double hi = std::log2((long double)(t + 1)) + m;
+	const long double eps = 1e-9;
+	if (std::floor(lo - eps) == std::floor(hi + eps))
+		return (uint)std::floor(lo) + 1;
+
+	uint b = (uint)std::floor(hi + eps);
+	Long x = *this;
+	x.changeSign(1);
+	return (x >= (pone << b)) ? b + 1 : b;
+}
+
+bool Long::test_bit(uint i) const
+{
+	if (i < 64)
+		return (low_bits() >> i) & 1;
+	WordStream s(a);
+	for (uint k = 0; k < i / 64; ++k) {
+		if (s.done())
+			return false;
+		s.next();
+	}
+	return (s.next() >> (i % 64)) & 1;
+}
+
+uint Long::ctz() const
+{
+	if (zero_limbs(a))
+		return 0;
+	ull w = low_bits();
+	if (w != 0)
+		return __builtin_ctzll(w);
+	WordStream s(a);
+	s.next();
+	for (uint k = 64; ; k += 64)
+		if ((w = s.next()) != 0)
+			return k + __builtin_ctzll(w);
+}
+
+uint Long::popcount() const
+{
+	uint c = 0;
+	for (auto w : to_words())
+		c += __builtin_popcountll(w);
+	return c;
+}
+
+Long Long::operator&(const Long& other) const
+{
+	auto x = to_words(), y = other.to_words();
+	x.resize(std::min(x.size(), y.size()));
+	for (uint i = 0; i < x.size(); ++i)
+		x[i] &= y[i];
+	return from_words(x);
+}
+
+Long Long::operator|(const Long& other) const
+{
+	auto x = to_words(), y = other.to_words();
+	if (x.size() < y.size())
+		swap(x, y);
+	for (uint i = 0; i < y.size(); ++i)
+		x[i] |= y[i];
+	return from_words(x);
+}
+
+Long Long::operator^(const Long& other) const
+{
+	auto x = to_words(), y = other.to_words();
+	if (x.size() < y.size())
+		swap(x, y);
+	for (uint i = 0; i < y.size(); ++i)
+		x[i] ^= y[i];
+	return from_words(x);
+}
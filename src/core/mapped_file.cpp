@@ -0,0 +1,141 @@
+#include "core/mapped_file.h"
+#include "core/limb_kernels.h"
+#include <algorithm>
+#include <stdexcept>
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#ifdef _WIN32
+MappedFile::MappedFile(const std::string& filename) : data_(nullptr), size_(0), file_(INVALID_HANDLE_VALUE), mapping_(nullptr)
+{
+	file_ = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	LARGE_INTEGER sz;
+	if (file_ == INVALID_HANDLE_VALUE || !GetFileSizeEx(file_, &sz)) {
+		release();
+		throw std::runtime_error("Could not open file: " + filename);
+	}
+	size_ = (size_t)sz.QuadPart;
+	if (size_ == 0)
+		return;
+	mapping_ = CreateFileMappingA(file_, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (mapping_)
+		data_ = static_cast<const unsigned char*>(MapViewOfFile(mapping_, FILE_MAP_READ, 0, 0, 0));
+	if (!data_) {
+		release();
+		throw std::runtime_error("Could not map file: " + filename);
+	}
+}
+
+void MappedFile::release()
+{
+	if (data_)
+		UnmapViewOfFile(data_);
+	if (mapping_)
+		CloseHandle(mapping_);
+	if (file_ != INVALID_HANDLE_VALUE)
+		CloseHandle(file_);
+	data_ = nullptr;
+	mapping_ = nullptr;
+	file_ = INVALID_HANDLE_VALUE;
+}
+#else
+// the descriptor is not needed once the pages are mapped
+MappedFile::MappedFile(const std::string& filename) : data_(nullptr), size_(0)
+{
+	int fd = open(filename.c_str(), O_RDONLY);
+	struct stat st;
+	if (fd < 0 || fstat(fd, &st) != 0) {
+		if (fd >= 0)
+			close(fd);
+		throw std::runtime_error("Could not open file: " + filename);
+	}
+	size_ = (size_t)st.st_size;
+	if (size_ > 0) {
+		void* p = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+		if (p == MAP_FAILED) {
+			close(fd);
+			throw std::runtime_error("Could not map file: " + filename);
+		}
+		data_ = static_cast<const unsigned char*>(p);
+	}
+	close(fd);
+}
+
+void MappedFile::release()
+{
+	if (data_)
+		munmap(const_cast<unsigned char*>(data_), size_);
+	data_ = nullptr;
+}
+#endif
+
+MappedFile::~MappedFile()
+{
+	release();
+}
+
+static_assert(serial::host_little_endian, "LongView: the records are little endian");
+
+LongView::LongView(const std::string& filename) : file_(std::make_shared<const MappedFile>(filename))
+{
+	serial::Header h = serial::get_header(file_->data(), file_->size(), serial::LONG);
+	if (h.n == 0 || h.n > UINT32_MAX || h.p > 1)
+		throw std::runtime_error("LongView: bad record");
+	serial::check_payload(file_->size() - serial::header_size, h.n, sizeof(ull));
+	limbs_ = reinterpret_cast<const ull*>(file_->data() + serial::header_size);
+	size_ = (uint)h.n;
+	negative_ = h.p == 1;
+}
+
+LongView::LongView(const ull* limbs, uint n, bool negative) : limbs_(limbs), size_(n), negative_(negative) {}
+
+LongView::LongView(const Long& x) : limbs_(x.container().data()), size_(x.size()), negative_(x < 0 && !x.is_zero()) {}
+
+int LongView::compare(const LongView& other) const
+{
+	bool neg = negative_ && !is_zero(), other_neg = other.negative_ && !other.is_zero();
+	if (neg != other_neg)
+		return neg ? -1 : 1;
+	int c = (size_ != other.size_) ? (size_ < other.size_ ? -1 : 1) : limbs_cmp(limbs_, other.limbs_, size_);
+	return neg ? -c : c;
+}
+
+ull LongView::mod_small(ull d) const
+{
+	if (d == 0)
+		throw std::runtime_error("Division by zero!");
+	return limbs_mod_small(limbs_, size_, d);
+}
+
+Long LongView::to_long() const
+{
+	return Long::from_limbs(limbs_, size_, negative_);
+}
+
+static const uint view_ntt_limbs = 100; // where Long's own products switch to the NTT
+
+Long operator*(const LongView& x, const LongView& y)
+{
+	if (std::min(x.size(), y.size()) < view_ntt_limbs)
+		return x.to_long() * y.to_long();
+	Long c = Long::ntt_product(x.limbs(), x.size(), y.limbs(), y.size());
+	return (x.negative() != y.negative()) ? -c : c;
+}
+
+bool operator==(const LongView& x, const LongView& y)
+{
+	return x.compare(y) == 0;
+}
+
+bool operator<(const LongView& x, const LongView& y)
+{
+	return x.compare(y) < 0;
+}
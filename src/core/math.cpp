@@ -28,7 +28,8 @@ Long rand(const uint s, const Long &c, bool(*condition)(const Long &a, const Lon
 Long abs(const Long & a)
 {
     auto t = a;
-    return t.changeSign();
+    t.changeSign(1);
+    return t;
 }
 Long factorial(const Long & N)
 {
@@ -41,24 +42,32 @@ Long factorial(const Long & N)
 }
 
 Long pow_mod(const Long& x, const Long& y, const Long& N) {
-    Long s = pone, t = x, u = y;
-    while (u != null) {
-        if (isodd(u))
-            s = (s * (t)) % N;
-        u = u / 2;
-        t = (t * (t)) % N;
+    Long s = pone, t = x;
+    auto w = y.to_words();
+    uint bits = y.bit_length();
+    for (uint i = 0; i < bits; ++i) {
+        if ((w[i / 64] >> (i % 64)) & 1) {
+            s *= t;
+            s %= N;
+        }
+        if (i + 1 < bits) {
+            t *= t;
+            t %= N;
+        }
     }
     return s;
 }
 Long pow(const Long & a, const Long & n) {
     Long res = pone;
-    auto _n = n, _a = a;
-    while (_n != 0) {
-        if (isodd(_n)) {
+    auto _a = a;
+    auto w = n.to_words();
+    uint bits = n.bit_length();
+    for (uint i = 0; i < bits; ++i) {
+        if ((w[i / 64] >> (i % 64)) & 1) {
             res = res * (_a);
         }
-        _a = _a * (_a);
-        _n = _n / 2;
+        if (i + 1 < bits)
+            _a = _a * (_a);
     }
     return res;
 }
@@ -69,21 +78,14 @@ Long gcd(const Long& u, const Long& v)
     if (u == null) return v;
     if (v == null) return u;
 
-    auto u_isodd = isodd(u),
-        v_isodd = isodd(v);
-
-    if (!u_isodd) // u is even
-    {
-        if (v_isodd) // v is odd
-            return gcd(u / 2, v);
-        else // both u and v are even
-            return gcd(u / 2, v / 2) * 2;
-    }
-    else if (!v_isodd) // u is odd, v is even
-        return gcd(u, v / 2);
-    // reduce larger argument
-    else if (u >= v)
-        return gcd((u - v) / 2, v);
-    else
-        return gcd((v - u) / 2, u);
-}
+    // binary gcd: all the 2s are stripped with one shift, both stay odd
+    uint k = std::min(u.ctz(), v.ctz());
+    auto x = u >> u.ctz(), y = v;
+    do {
+        y = y >> y.ctz();
+        if (x > y)
+            swap(x, y);
+        y = y - x;
+    } while (y != null);
+    return x << k;
+}
\ No newline at end of file
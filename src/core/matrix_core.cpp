@@ -5,27 +5,56 @@
 // Core Matrix class implementations
 
 template<typename T>
-Matrix<T>::Matrix() : rows_(0), cols_(0) {}
+Matrix<T>::Matrix() : rows_(0), cols_(0), data_(nullptr) {}
 
 template<typename T>
 Matrix<T>::Matrix(size_type rows, size_type cols) 
-    : rows_(rows), cols_(cols), data_(rows * cols, T{}) {}
+    : rows_(rows), cols_(cols), storage_(rows * cols, T{}), data_(storage_.data()) {}
 
 template<typename T>
 Matrix<T>::Matrix(size_type rows, size_type cols, value_type value)
-    : rows_(rows), cols_(cols), data_(rows * cols, value) {}
+    : rows_(rows), cols_(cols), storage_(rows * cols, value), data_(storage_.data()) {}
 
 template<typename T>
-Matrix<T>::Matrix(const Matrix& other) = default;
+Matrix<T>::Matrix(Borrow, size_type rows, size_type cols, const value_type* data)
+    : rows_(rows), cols_(cols), data_(const_cast<value_type*>(data)) {}
 
 template<typename T>
-Matrix<T>::Matrix(Matrix&& other) noexcept = default;
+Matrix<T>::Matrix(const Matrix& other)
+    : rows_(other.rows_), cols_(other.cols_),
+      storage_(other.data_, other.data_ + other.count()), data_(storage_.data()) {}
 
+// a moved vector keeps its buffer, so data_ stays valid whether owned or borrowed
 template<typename T>
-Matrix<T>& Matrix<T>::operator=(const Matrix& other) = default;
+Matrix<T>::Matrix(Matrix&& other) noexcept
+    : rows_(other.rows_), cols_(other.cols_), storage_(std::move(other.storage_)), data_(other.data_) {
+    other.rows_ = other.cols_ = 0;
+    other.data_ = nullptr;
+}
 
 template<typename T>
-Matrix<T>& Matrix<T>::operator=(Matrix&& other) noexcept = default;
+Matrix<T>& Matrix<T>::operator=(const Matrix& other) {
+    if (this != &other) {
+        storage_.assign(other.data_, other.data_ + other.count());
+        rows_ = other.rows_;
+        cols_ = other.cols_;
+        data_ = storage_.data();
+    }
+    return *this;
+}
+
+template<typename T>
+Matrix<T>& Matrix<T>::operator=(Matrix&& other) noexcept {
+    if (this != &other) {
+        storage_ = std::move(other.storage_);
+        rows_ = other.rows_;
+        cols_ = other.cols_;
+        data_ = other.data_;
+        other.rows_ = other.cols_ = 0;
+        other.data_ = nullptr;
+    }
+    return *this;
+}
 
 template<typename T>
 Matrix<T>::~Matrix() = default;
@@ -48,7 +77,7 @@ Matrix<T> Matrix<T>::operator+(const Matrix& other) const {
         throw std::invalid_argument("Matrix dimensions must match for addition");
     }
     Matrix result(rows_, cols_);
-    for (size_type i = 0; i < data_.size(); ++i) {
+    for (size_type i = 0; i < count(); ++i) {
         result.data_[i] = data_[i] + other.data_[i];
     }
     return result;
@@ -57,7 +86,7 @@ Matrix<T> Matrix<T>::operator+(const Matrix& other) const {
 template<typename T>
 Matrix<T> Matrix<T>::operator+(value_type scalar) const {
     Matrix result(rows_, cols_);
-    for (size_type i = 0; i < data_.size(); ++i) {
+    for (size_type i = 0; i < count(); ++i) {
         result.data_[i] = data_[i] + scalar;
     }
     return result;
@@ -66,7 +95,7 @@ Matrix<T> Matrix<T>::operator+(value_type scalar) const {
 template<typename T>
 Matrix<T> Matrix<T>::operator-(value_type scalar) const {
     Matrix result(rows_, cols_);
-    for (size_type i = 0; i < data_.size(); ++i) {
+    for (size_type i = 0; i < count(); ++i) {
         result.data_[i] = data_[i] - scalar;
     }
     return result;
@@ -78,7 +107,7 @@ Matrix<T> Matrix<T>::operator-(const Matrix& other) const {
         throw std::invalid_argument("Matrix dimensions must match for subtraction");
     }
     Matrix result(rows_, cols_);
-    for (size_type i = 0; i < data_.size(); ++i) {
+    for (size_type i = 0; i < count(); ++i) {
         result.data_[i] = data_[i] - other.data_[i];
     }
     return result;
@@ -92,7 +121,7 @@ Matrix<T> Matrix<T>::operator*(const Matrix& other) const {
 template<typename T>
 Matrix<T>& Matrix<T>::operator+=(const Matrix& other) {
     check_dimensions(other, "addition");
-    for (size_type i = 0; i < data_.size(); ++i) {
+    for (size_type i = 0; i < count(); ++i) {
         data_[i] += other.data_[i];
     }
     return *this;
@@ -101,7 +130,7 @@ Matrix<T>& Matrix<T>::operator+=(const Matrix& other) {
 template<typename T>
 Matrix<T>& Matrix<T>::operator-=(const Matrix& other) {
     check_dimensions(other, "subtraction");
-    for (size_type i = 0; i < data_.size(); ++i) {
+    for (size_type i = 0; i < count(); ++i) {
         data_[i] -= other.data_[i];
     }
     return *this;
@@ -109,7 +138,7 @@ Matrix<T>& Matrix<T>::operator-=(const Matrix& other) {
 
 template<typename T>
 Matrix<T>& Matrix<T>::operator*=(value_type scalar) {
-    for (size_type i = 0; i < data_.size(); ++i) {
+    for (size_type i = 0; i < count(); ++i) {
         data_[i] *= scalar;
     }
     return *this;
@@ -122,7 +151,7 @@ bool Matrix<T>::operator==(const Matrix& other) const {
         return false;
     }
     
-    for (size_type i = 0; i < data_.size(); ++i) {
+    for (size_type i = 0; i < count(); ++i) {
         if (data_[i] != other.data_[i]) {
             return false;
         }
@@ -138,7 +167,7 @@ bool Matrix<T>::operator!=(const Matrix& other) const {
 template<typename T>
 Matrix<T> Matrix<T>::operator*(value_type scalar) const {
     Matrix result(rows_, cols_);
-    for (size_type i = 0; i < data_.size(); ++i) {
+    for (size_type i = 0; i < count(); ++i) {
         result.data_[i] = data_[i] * scalar;
     }
     return result;
@@ -241,6 +270,8 @@ Matrix<T> Matrix<T>::multiply(const Matrix& other, typename Matrix<T>::MatrixMul
             return Matrix<T>::AutoMatrixMultiplicationAlgorithm::multiply(*this, other);
         case Matrix<T>::MatrixMultiplicationAlgorithm::AlgorithmType::ALPHA_TENSOR:
             return Matrix<T>::AlphaTensorMatrixMultiplicationAlgorithm::multiply(*this, other);
+        case Matrix<T>::MatrixMultiplicationAlgorithm::AlgorithmType::BLOCKED_GEMM:
+            return Matrix<T>::BlockedGemmMatrixMultiplicationAlgorithm::multiply(*this, other);
         default:
             throw std::invalid_argument("Invalid algorithm type");
     }
@@ -23,18 +23,23 @@ Matrix<T>* Matrix<T>::AlphaTensorMatrixMultiplicationAlgorithm::compute_from_blo
     size_type n = 4;  // 4 blocks per row
     size_type m = 4;  // 4 blocks per column
     
+    // The 49 products are independent: blocks large enough run them as tasks
+    TaskGroup products(A_blocks[0].rows() >= AlphaTensorMatrixMultiplicationAlgorithm::parallel_block_size);
     for (size_type r = 0; r < p_size_m; ++r){
-        Matrix<T> res_1 = Matrix<T>(A_blocks[0].rows(), A_blocks[0].cols());
-        Matrix<T> res_2 = Matrix<T>(B_blocks[0].rows(), B_blocks[0].cols());
-        for (size_type i = 0; i < n; ++i){
-            for (size_type j = 0; j < m; ++j){
-                auto pos = (i * 4 + j) * p_size_m + r;
-                res_1 += A_blocks[i * 4 + j] * u[pos];
-                res_2 += B_blocks[i * 4 + j] * v[pos];
+        products.run([&, r] {
+            Matrix<T> res_1 = Matrix<T>(A_blocks[0].rows(), A_blocks[0].cols());
+            Matrix<T> res_2 = Matrix<T>(B_blocks[0].rows(), B_blocks[0].cols());
+            for (size_type i = 0; i < n; ++i){
+                for (size_type j = 0; j < m; ++j){
+                    auto pos = (i * 4 + j) * p_size_m + r;
+                    res_1 += A_blocks[i * 4 + j] * u[pos];
+                    res_2 += B_blocks[i * 4 + j] * v[pos];
+                }
             }
-        }
-        m_array[r] = res_1 * res_2;
+            m_array[r] = res_1 * res_2;
+        });
     }
+    products.wait();
 
     for (size_type i = 0; i < 4; ++i){
         for (size_type j = 0; j < 4; ++j){
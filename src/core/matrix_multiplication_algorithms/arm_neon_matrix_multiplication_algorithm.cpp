@@ -2,12 +2,15 @@
 #include "core/matrix.h"
 #else
 
+#ifdef __ARM_NEON
 #include <arm_neon.h>  // For ARM NEON intrinsics
+#endif
 #include <cstring>     // For memcpy
 
 // ARM NEON-optimized Matrix Multiplication Algorithm
 template<typename T>
 Matrix<T> Matrix<T>::ArmNeonMatrixMultiplicationAlgorithm::multiply(const Matrix<T>& matrix, const Matrix<T>& other) {
+#ifdef __ARM_NEON
     Matrix<T>::MatrixMultiplicationAlgorithm::validate_dimensions(matrix, other);
     Matrix<T> result = Matrix<T>::MatrixMultiplicationAlgorithm::construct_result(matrix, other);
     
@@ -16,31 +19,40 @@ Matrix<T> Matrix<T>::ArmNeonMatrixMultiplicationAlgorithm::multiply(const Matrix
     // For double precision, we can process 2 elements at once with NEON
     constexpr size_type SIMD_WIDTH = 2;  // 128-bit / 64-bit = 2 doubles
     
+    // Transpose B once for better cache locality; the row panels share it
+    Matrix<T> other_transposed = other.transpose();
+    
     // Ensure matrices are aligned for SIMD operations
     if (inner_dim % SIMD_WIDTH == 0) {
         // Optimized path for aligned data
-        neon_multiply_aligned(matrix, other, result);
+        Matrix<T>::MatrixMultiplicationAlgorithm::for_row_panels(matrix, other, [&](size_type first, size_type last) {
+            neon_multiply_aligned(matrix, other_transposed, result, first, last);
+        });
     } else {
         // Fallback for unaligned data
-        neon_multiply_unaligned(matrix, other, result);
+        Matrix<T>::MatrixMultiplicationAlgorithm::for_row_panels(matrix, other, [&](size_type first, size_type last) {
+            neon_multiply_unaligned(matrix, other_transposed, result, first, last);
+        });
     }
     
     return result;
+#else
+    // Fallback to naive implementation on non-ARM architectures
+    return multiply_fallback(matrix, other);
+#endif
 }
 
+#ifdef __ARM_NEON
+
 template<typename T>
 void Matrix<T>::ArmNeonMatrixMultiplicationAlgorithm::neon_multiply_aligned(
-    const Matrix<T>& A, const Matrix<T>& B, Matrix<T>& C) {
+    const Matrix<T>& A, const Matrix<T>& B_transposed, Matrix<T>& C, size_type first, size_type last) {
     
-    const size_type rows = A.rows();
-    const size_type cols = B.cols();
+    const size_type cols = B_transposed.rows();
     const size_type inner_dim = A.cols();
     const size_type simd_width = 2;  // NEON for doubles
     
-    // Transpose B for better cache locality and SIMD efficiency
-    Matrix<T> B_transposed = B.transpose();
-    
-    for (size_type i = 0; i < rows; ++i) {
+    for (size_type i = first; i < last; ++i) {
         for (size_type j = 0; j < cols; ++j) {
             float64x2_t sum = vdupq_n_f64(0.0);  // Initialize sum to zero
             
@@ -67,18 +79,14 @@ void Matrix<T>::ArmNeonMatrixMultiplicationAlgorithm::neon_multiply_aligned(
 
 template<typename T>
 void Matrix<T>::ArmNeonMatrixMultiplicationAlgorithm::neon_multiply_unaligned(
-    const Matrix<T>& A, const Matrix<T>& B, Matrix<T>& C) {
+    const Matrix<T>& A, const Matrix<T>& B_transposed, Matrix<T>& C, size_type first, size_type last) {
     
-    const size_type rows = A.rows();
-    const size_type cols = B.cols();
+    const size_type cols = B_transposed.rows();
     const size_type inner_dim = A.cols();
     const size_type simd_width = 2;
     const size_type aligned_inner = (inner_dim / simd_width) * simd_width;
     
-    // Transpose B for better cache locality
-    Matrix<T> B_transposed = B.transpose();
-    
-    for (size_type i = 0; i < rows; ++i) {
+    for (size_type i = first; i < last; ++i) {
         for (size_type j = 0; j < cols; ++j) {
             float64x2_t sum = vdupq_n_f64(0.0);
             
@@ -104,11 +112,15 @@ void Matrix<T>::ArmNeonMatrixMultiplicationAlgorithm::neon_multiply_unaligned(
     }
 }
 
+#endif // __ARM_NEON
+
 // Alternative implementation with loop reordering for better cache performance
 template<typename T>
 Matrix<T> Matrix<T>::ArmNeonMatrixMultiplicationAlgorithm::multiply_optimized(
     const Matrix<T>& matrix, const Matrix<T>& other) {
-    
+#ifndef __ARM_NEON
+    return multiply_fallback(matrix, other);
+#else
     Matrix<T>::MatrixMultiplicationAlgorithm::validate_dimensions(matrix, other);
     Matrix<T> result = Matrix<T>::MatrixMultiplicationAlgorithm::construct_result(matrix, other);
     
@@ -148,6 +160,7 @@ Matrix<T> Matrix<T>::ArmNeonMatrixMultiplicationAlgorithm::multiply_optimized(
     }
     
     return result;
+#endif
 }
 
 // Check if ARM NEON is available at runtime
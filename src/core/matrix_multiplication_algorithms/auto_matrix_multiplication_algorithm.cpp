@@ -19,6 +19,8 @@ Matrix<T> Matrix<T>::AutoMatrixMultiplicationAlgorithm::multiply(const Matrix<T>
             return Matrix<T>::WinogradMatrixMultiplicationAlgorithm::multiply(matrix, other);
         case Matrix<T>::MatrixMultiplicationAlgorithm::AlgorithmType::ALPHA_TENSOR:
             return Matrix<T>::AlphaTensorMatrixMultiplicationAlgorithm::multiply(matrix, other);
+        case Matrix<T>::MatrixMultiplicationAlgorithm::AlgorithmType::BLOCKED_GEMM:
+            return Matrix<T>::BlockedGemmMatrixMultiplicationAlgorithm::multiply(matrix, other);
         case Matrix<T>::MatrixMultiplicationAlgorithm::AlgorithmType::AUTO:
             // Fallback to naive for AUTO case to avoid infinite recursion
             return Matrix<T>::NaiveMatrixMultiplicationAlgorithm::multiply(matrix, other);
@@ -38,7 +40,7 @@ typename Matrix<T>::MatrixMultiplicationAlgorithm::AlgorithmType Matrix<T>::Auto
     } else if (size <= Matrix<T>::AutoMatrixMultiplicationAlgorithm::get_thresholds().alpha_tensor_threshold) {
         return Matrix<T>::MatrixMultiplicationAlgorithm::AlgorithmType::ALPHA_TENSOR;
     } else {
-        throw std::invalid_argument("Invalid algorithm type");
+        return Matrix<T>::MatrixMultiplicationAlgorithm::AlgorithmType::BLOCKED_GEMM;
     }
 }
 
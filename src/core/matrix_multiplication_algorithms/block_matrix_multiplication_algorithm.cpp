@@ -40,10 +40,10 @@ Matrix<T> Matrix<T>::BlockMatrixMultiplicationAlgorithm<block_num, Derived>::spl
         }
     }
     
-    auto C_blocks = Derived::compute_from_blocks(A_blocks, B_blocks);
+    std::unique_ptr<Matrix<T>[]> C_blocks(Derived::compute_from_blocks(A_blocks, B_blocks));
     
     // recombine to the original size
-    return BlockMatrixMultiplicationAlgorithm<block_num, Derived>::combine_blocks(C_blocks, n);
+    return BlockMatrixMultiplicationAlgorithm<block_num, Derived>::combine_blocks(C_blocks.get(), n);
 }
     
 template<typename T>
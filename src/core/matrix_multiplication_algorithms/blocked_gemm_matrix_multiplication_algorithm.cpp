@@ -0,0 +1,214 @@
+#ifndef MATRIX_FUNCTIONS
+#include "core/matrix.h"
+#else
+
+#if defined(__x86_64__) && (defined(__AVX512F__) || (defined(__AVX2__) && defined(__FMA__)))
+#include <immintrin.h>  // For AVX-512 / AVX2 FMA intrinsics
+#endif
+#include <type_traits>
+#include <vector>
+
+// Blocking of C += A * B (the loops of BLIS):
+//   jc by NC columns: a KC x NC panel of B is packed, meant for L3
+//   pc by KC        : ... for each one
+//   ic by MC rows   : an MC x KC block of A is packed, meant for L2
+//   jr, ir          : an MR x NR tile of C in registers; a KC x NR sliver
+//                     of B stays in L1 while the slivers of A stream by
+// Packed panels are padded with zeros to whole tiles, so the kernel always
+// runs on MR x NR and only the edge tiles of C go through a small buffer.
+template<typename T>
+struct GemmTile {
+    static constexpr size_type MR = 4, NR = 8;
+    static constexpr size_type MC = 64, KC = 256, NC = 4096;
+};
+
+#if defined(__x86_64__) && defined(__AVX512F__)
+template<>
+struct GemmTile<double> {
+    static constexpr size_type MR = 8, NR = 24;   // 24 zmm accumulators
+    static constexpr size_type MC = 240, KC = 192, NC = 4080;
+};
+#elif defined(__x86_64__) && defined(__AVX2__) && defined(__FMA__)
+template<>
+struct GemmTile<double> {
+    static constexpr size_type MR = 6, NR = 8;    // 12 ymm accumulators
+    static constexpr size_type MC = 72, KC = 256, NC = 4080;
+};
+#endif
+
+// A(row.., col..) as mc / MR slivers, each kc columns of MR rows
+template<typename T>
+void Matrix<T>::BlockedGemmMatrixMultiplicationAlgorithm::pack_a(
+    const Matrix<T>& A, size_type row, size_type col, size_type mc, size_type kc, value_type* to) {
+    constexpr size_type MR = GemmTile<T>::MR;
+    const size_type lda = A.cols();
+    for (size_type i = 0; i < mc; i += MR) {
+        const size_type mr = std::min(MR, mc - i);
+        const value_type* from = A.data() + (row + i) * lda + col;
+        for (size_type k = 0; k < kc; ++k) {
+            size_type r = 0;
+            for (; r < mr; ++r) {
+                to[r] = from[r * lda + k];
+            }
+            for (; r < MR; ++r) {
+                to[r] = value_type(0);
+            }
+            to += MR;
+        }
+    }
+}
+
+// B(row.., col..) as nc / NR slivers, each kc rows of NR columns
+template<typename T>
+void Matrix<T>::BlockedGemmMatrixMultiplicationAlgorithm::pack_b(
+    const Matrix<T>& B, size_type row, size_type col, size_type kc, size_type nc, value_type* to) {
+    constexpr size_type NR = GemmTile<T>::NR;
+    const size_type ldb = B.cols();
+    for (size_type j = 0; j < nc; j += NR) {
+        const size_type nr = std::min(NR, nc - j);
+        const value_type* from = B.data() + row * ldb + col + j;
+        for (size_type k = 0; k < kc; ++k) {
+            size_type c = 0;
+            for (; c < nr; ++c) {
+                to[c] = from[k * ldb + c];
+            }
+            for (; c < NR; ++c) {
+                to[c] = value_type(0);
+            }
+            to += NR;
+        }
+    }
+}
+
+// c(MR x NR, rows ldc apart) += a sliver * b sliver
+template<typename T>
+void Matrix<T>::BlockedGemmMatrixMultiplicationAlgorithm::micro_kernel(
+    size_type kc, const value_type* a, const value_type* b, value_type* c, size_type ldc) {
+    constexpr size_type MR = GemmTile<T>::MR, NR = GemmTile<T>::NR;
+#if defined(__x86_64__) && defined(__AVX512F__)
+    if constexpr (std::is_same<T, double>::value) {
+        __m512d acc[MR][3];
+#pragma GCC unroll 8
+        for (size_type i = 0; i < MR; ++i) {
+            acc[i][0] = acc[i][1] = acc[i][2] = _mm512_setzero_pd();
+        }
+        for (size_type k = 0; k < kc; ++k, a += MR, b += NR) {
+            const __m512d b0 = _mm512_loadu_pd(b), b1 = _mm512_loadu_pd(b + 8), b2 = _mm512_loadu_pd(b + 16);
+#pragma GCC unroll 8
+            for (size_type i = 0; i < MR; ++i) {
+                const __m512d ai = _mm512_set1_pd(a[i]);
+                acc[i][0] = _mm512_fmadd_pd(ai, b0, acc[i][0]);
+                acc[i][1] = _mm512_fmadd_pd(ai, b1, acc[i][1]);
+                acc[i][2] = _mm512_fmadd_pd(ai, b2, acc[i][2]);
+            }
+        }
+#pragma GCC unroll 8
+        for (size_type i = 0; i < MR; ++i) {
+            double* ci = c + i * ldc;
+            _mm512_storeu_pd(ci, _mm512_add_pd(_mm512_loadu_pd(ci), acc[i][0]));
+            _mm512_storeu_pd(ci + 8, _mm512_add_pd(_mm512_loadu_pd(ci + 8), acc[i][1]));
+            _mm512_storeu_pd(ci + 16, _mm512_add_pd(_mm512_loadu_pd(ci + 16), acc[i][2]));
+        }
+        return;
+    }
+#elif defined(__x86_64__) && defined(__AVX2__) && defined(__FMA__)
+    if constexpr (std::is_same<T, double>::value) {
+        __m256d acc[MR][2];
+#pragma GCC unroll 6
+        for (size_type i = 0; i < MR; ++i) {
+            acc[i][0] = acc[i][1] = _mm256_setzero_pd();
+        }
+        for (size_type k = 0; k < kc; ++k, a += MR, b += NR) {
+            const __m256d b0 = _mm256_loadu_pd(b), b1 = _mm256_loadu_pd(b + 4);
+#pragma GCC unroll 6
+            for (size_type i = 0; i < MR; ++i) {
+                const __m256d ai = _mm256_broadcast_sd(a + i);
+                acc[i][0] = _mm256_fmadd_pd(ai, b0, acc[i][0]);
+                acc[i][1] = _mm256_fmadd_pd(ai, b1, acc[i][1]);
+            }
+        }
+#pragma GCC unroll 6
+        for (size_type i = 0; i < MR; ++i) {
+            double* ci = c + i * ldc;
+            _mm256_storeu_pd(ci, _mm256_add_pd(_mm256_loadu_pd(ci), acc[i][0]));
+            _mm256_storeu_pd(ci + 4, _mm256_add_pd(_mm256_loadu_pd(ci + 4), acc[i][1]));
+        }
+        return;
+    }
+#endif
+    value_type acc[MR][NR] = {};
+    for (size_type k = 0; k < kc; ++k, a += MR, b += NR) {
+        for (size_type i = 0; i < MR; ++i) {
+            for (size_type j = 0; j < NR; ++j) {
+                acc[i][j] += a[i] * b[j];
+            }
+        }
+    }
+    for (size_type i = 0; i < MR; ++i) {
+        for (size_type j = 0; j < NR; ++j) {
+            c[i * ldc + j] += acc[i][j];
+        }
+    }
+}
+
+template<typename T>
+Matrix<T> Matrix<T>::BlockedGemmMatrixMultiplicationAlgorithm::multiply(const Matrix<T>& matrix, const Matrix<T>& other) {
+    Matrix<T>::MatrixMultiplicationAlgorithm::validate_dimensions(matrix, other);
+    Matrix<T> result = Matrix<T>::MatrixMultiplicationAlgorithm::construct_result(matrix, other);
+
+    using Tile = GemmTile<T>;
+    constexpr size_type MR = Tile::MR, NR = Tile::NR;
+    const size_type m = matrix.rows(), n = other.cols(), k = matrix.cols();
+    const size_type nc_max = std::min(Tile::NC, (n + NR - 1) / NR * NR);
+    // The ic blocks run in parallel, each with its own packed A, all sharing
+    // the packed B; with more threads than blocks of MC rows the blocks get
+    // smaller so that every thread has one.
+    const size_type threads = TaskScheduler::instance().threads();
+    const size_type mc_step = std::min(Tile::MC, std::max(MR, ((m + threads - 1) / threads + MR - 1) / MR * MR));
+    const size_type blocks = (m + mc_step - 1) / mc_step;
+    std::vector<value_type> b_pack(Tile::KC * nc_max);
+    value_type* c = result.data();
+
+    for (size_type jc = 0; jc < n; jc += Tile::NC) {
+        const size_type nc = std::min(Tile::NC, n - jc);
+        for (size_type pc = 0; pc < k; pc += Tile::KC) {
+            const size_type kc = std::min(Tile::KC, k - pc);
+            parallel_for(0, (nc + NR - 1) / NR, 16, [&](size_type first, size_type last) {
+                const size_type j = first * NR;
+                pack_b(other, pc, jc + j, kc, std::min(nc, last * NR) - j, b_pack.data() + j * kc);
+            });
+            parallel_for(0, blocks, 1, [&](size_type first, size_type last) {
+                thread_local std::vector<value_type> a_pack;
+                a_pack.resize(Tile::MC * Tile::KC);
+                for (size_type ic = first * mc_step; ic < std::min(m, last * mc_step); ic += mc_step) {
+                    const size_type mc = std::min(mc_step, m - ic);
+                    pack_a(matrix, ic, pc, mc, kc, a_pack.data());
+                    for (size_type jr = 0; jr < nc; jr += NR) {
+                        const size_type nr = std::min(NR, nc - jr);
+                        for (size_type ir = 0; ir < mc; ir += MR) {
+                            const size_type mr = std::min(MR, mc - ir);
+                            const value_type* a = a_pack.data() + ir * kc;
+                            const value_type* b = b_pack.data() + jr * kc;
+                            value_type* cij = c + (ic + ir) * n + jc + jr;
+                            if (mr == MR && nr == NR) {
+                                micro_kernel(kc, a, b, cij, n);
+                                continue;
+                            }
+                            // edge tile: through a full one, then only its valid part
+                            value_type tile[MR * NR] = {};
+                            micro_kernel(kc, a, b, tile, NR);
+                            for (size_type i = 0; i < mr; ++i) {
+                                for (size_type j = 0; j < nr; ++j) {
+                                    cij[i * n + j] += tile[i * NR + j];
+                                }
+                            }
+                        }
+                    }
+                }
+            });
+        }
+    }
+    return result;
+}
+
+#endif // MATRIX_FUNCTIONS
@@ -25,5 +25,13 @@ void Matrix<T>::MatrixMultiplicationAlgorithm::validate_dimensions(const Matrix<
     }
 }
 
+template<typename T>
+template<typename F>
+void Matrix<T>::MatrixMultiplicationAlgorithm::for_row_panels(const Matrix<T>& matrix, const Matrix<T>& other, F f) {
+    // a panel is worth a task from about 64K multiply-adds up
+    const size_type row_work = std::max<size_type>(1, matrix.cols() * other.cols());
+    parallel_for(0, matrix.rows(), std::max<size_type>(1, (size_type(1) << 16) / row_work), f);
+}
+
 #endif // MATRIX_FUNCTIONS
 
@@ -8,15 +8,17 @@ Matrix<T> Matrix<T>::NaiveMatrixMultiplicationAlgorithm::multiply(const Matrix<T
     Matrix<T>::MatrixMultiplicationAlgorithm::validate_dimensions(matrix, other);
     Matrix<T> result = Matrix<T>::MatrixMultiplicationAlgorithm::construct_result(matrix, other);
     
-    for (size_type i = 0; i < matrix.rows(); ++i) {
-        for (size_type j = 0; j < other.cols(); ++j) {
-            value_type sum = 0.0;
-            for (size_type k = 0; k < matrix.cols(); ++k) {
-                sum += matrix(i, k) * other(k, j);
+    Matrix<T>::MatrixMultiplicationAlgorithm::for_row_panels(matrix, other, [&](size_type first, size_type last) {
+        for (size_type i = first; i < last; ++i) {
+            for (size_type j = 0; j < other.cols(); ++j) {
+                value_type sum = 0.0;
+                for (size_type k = 0; k < matrix.cols(); ++k) {
+                    sum += matrix(i, k) * other(k, j);
+                }
+                result(i, j) = sum;
             }
-            result(i, j) = sum;
         }
-    }
+    });
     
     return result;
 }
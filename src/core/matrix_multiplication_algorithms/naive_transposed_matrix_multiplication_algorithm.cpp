@@ -9,14 +9,16 @@ Matrix<T> Matrix<T>::NaiveTransposedMatrixMultiplicationAlgorithm::multiply(cons
     Matrix<T> result = Matrix<T>::MatrixMultiplicationAlgorithm::construct_result(matrix, other);
     Matrix<T> other_transposed = other.transpose();
 
-    for (size_type i = 0; i < matrix.rows(); ++i) {
-        for (size_type k = 0; k < matrix.cols(); ++k) {
-            T a_ik = matrix(i, k);
-            for (size_type j = 0; j < other_transposed.cols(); ++j) {
-                result(i, j) += a_ik * other_transposed(j, k);
+    Matrix<T>::MatrixMultiplicationAlgorithm::for_row_panels(matrix, other, [&](size_type first, size_type last) {
+        for (size_type i = first; i < last; ++i) {
+            for (size_type k = 0; k < matrix.cols(); ++k) {
+                T a_ik = matrix(i, k);
+                for (size_type j = 0; j < other_transposed.cols(); ++j) {
+                    result(i, j) += a_ik * other_transposed(j, k);
+                }
             }
         }
-    }
+    });
     
     return result;
 }
@@ -14,20 +14,25 @@ Matrix<T> Matrix<T>::SimdNaiveMatrixMultiplicationAlgorithm::multiply(const Matr
     Matrix<T>::MatrixMultiplicationAlgorithm::validate_dimensions(matrix, other);
     Matrix<T> result = Matrix<T>::MatrixMultiplicationAlgorithm::construct_result(matrix, other);
     
-    const size_type rows = matrix.rows();
-    const size_type cols = other.cols();
     const size_type inner_dim = matrix.cols();
     
     // For double precision, we can process 4 elements at once with AVX2
     constexpr size_type SIMD_WIDTH = 4;  // 256-bit / 64-bit = 4 doubles
     
+    // Transpose B once for better cache locality; the row panels share it
+    Matrix<T> other_transposed = other.transpose();
+    
     // Ensure matrices are aligned for SIMD operations
     if (inner_dim % SIMD_WIDTH == 0) {
         // Optimized path for aligned data
-        simd_multiply_aligned(matrix, other, result);
+        Matrix<T>::MatrixMultiplicationAlgorithm::for_row_panels(matrix, other, [&](size_type first, size_type last) {
+            simd_multiply_aligned(matrix, other_transposed, result, first, last);
+        });
     } else {
         // Fallback for unaligned data
-        simd_multiply_unaligned(matrix, other, result);
+        Matrix<T>::MatrixMultiplicationAlgorithm::for_row_panels(matrix, other, [&](size_type first, size_type last) {
+            simd_multiply_unaligned(matrix, other_transposed, result, first, last);
+        });
     }
     
     return result;
@@ -40,17 +45,13 @@ Matrix<T> Matrix<T>::SimdNaiveMatrixMultiplicationAlgorithm::multiply(const Matr
 #ifdef __x86_64__
 template<typename T>
 void Matrix<T>::SimdNaiveMatrixMultiplicationAlgorithm::simd_multiply_aligned(
-    const Matrix<T>& A, const Matrix<T>& B, Matrix<T>& C) {
+    const Matrix<T>& A, const Matrix<T>& B_transposed, Matrix<T>& C, size_type first, size_type last) {
     
-    const size_type rows = A.rows();
-    const size_type cols = B.cols();
+    const size_type cols = B_transposed.rows();
     const size_type inner_dim = A.cols();
     const size_type simd_width = 4;  // AVX2 for doubles
     
-    // Transpose B for better cache locality and SIMD efficiency
-    Matrix<T> B_transposed = B.transpose();
-    
-    for (size_type i = 0; i < rows; ++i) {
+    for (size_type i = first; i < last; ++i) {
         for (size_type j = 0; j < cols; ++j) {
             __m256d sum = _mm256_setzero_pd();  // Initialize sum to zero
             
@@ -76,18 +77,14 @@ void Matrix<T>::SimdNaiveMatrixMultiplicationAlgorithm::simd_multiply_aligned(
 }
 template<typename T>
 void Matrix<T>::SimdNaiveMatrixMultiplicationAlgorithm::simd_multiply_unaligned(
-    const Matrix<T>& A, const Matrix<T>& B, Matrix<T>& C) {
+    const Matrix<T>& A, const Matrix<T>& B_transposed, Matrix<T>& C, size_type first, size_type last) {
     
-    const size_type rows = A.rows();
-    const size_type cols = B.cols();
+    const size_type cols = B_transposed.rows();
     const size_type inner_dim = A.cols();
     const size_type simd_width = 4;
     const size_type aligned_inner = (inner_dim / simd_width) * simd_width;
     
-    // Transpose B for better cache locality
-    Matrix<T> B_transposed = B.transpose();
-    
-    for (size_type i = 0; i < rows; ++i) {
+    for (size_type i = first; i < last; ++i) {
         for (size_type j = 0; j < cols; ++j) {
             __m256d sum = _mm256_setzero_pd();
             
@@ -5,13 +5,17 @@
 // StrassenMatrixMultiplicationAlgorithm class implementation
 template<typename T>
 Matrix<T>* Matrix<T>::StrassenMatrixMultiplicationAlgorithm::compute_from_blocks(const Matrix<T>* A_blocks, const Matrix<T>* B_blocks) {
-    Matrix<T> P1 = StrassenMatrixMultiplicationAlgorithm::split_and_multiply(A_blocks[0], B_blocks[1] - B_blocks[3]);
-    Matrix<T> P2 = StrassenMatrixMultiplicationAlgorithm::split_and_multiply(A_blocks[0] + A_blocks[1], B_blocks[3]);
-    Matrix<T> P3 = StrassenMatrixMultiplicationAlgorithm::split_and_multiply(A_blocks[2] + A_blocks[3], B_blocks[0]);
-    Matrix<T> P4 = StrassenMatrixMultiplicationAlgorithm::split_and_multiply(A_blocks[3], B_blocks[2] - B_blocks[0]);
-    Matrix<T> P5 = StrassenMatrixMultiplicationAlgorithm::split_and_multiply(A_blocks[0] + A_blocks[3], B_blocks[0] + B_blocks[3]);
-    Matrix<T> P6 = StrassenMatrixMultiplicationAlgorithm::split_and_multiply(A_blocks[1] - A_blocks[3], B_blocks[2] + B_blocks[3]);
-    Matrix<T> P7 = StrassenMatrixMultiplicationAlgorithm::split_and_multiply(A_blocks[0] - A_blocks[2], B_blocks[0] + B_blocks[1]);
+    // The seven products are independent: blocks large enough run them as tasks
+    Matrix<T> P1, P2, P3, P4, P5, P6, P7;
+    TaskGroup products(A_blocks[0].rows() >= StrassenMatrixMultiplicationAlgorithm::parallel_block_size);
+    products.run([&] { P1 = StrassenMatrixMultiplicationAlgorithm::split_and_multiply(A_blocks[0], B_blocks[1] - B_blocks[3]); });
+    products.run([&] { P2 = StrassenMatrixMultiplicationAlgorithm::split_and_multiply(A_blocks[0] + A_blocks[1], B_blocks[3]); });
+    products.run([&] { P3 = StrassenMatrixMultiplicationAlgorithm::split_and_multiply(A_blocks[2] + A_blocks[3], B_blocks[0]); });
+    products.run([&] { P4 = StrassenMatrixMultiplicationAlgorithm::split_and_multiply(A_blocks[3], B_blocks[2] - B_blocks[0]); });
+    products.run([&] { P5 = StrassenMatrixMultiplicationAlgorithm::split_and_multiply(A_blocks[0] + A_blocks[3], B_blocks[0] + B_blocks[3]); });
+    products.run([&] { P6 = StrassenMatrixMultiplicationAlgorithm::split_and_multiply(A_blocks[1] - A_blocks[3], B_blocks[2] + B_blocks[3]); });
+    products.run([&] { P7 = StrassenMatrixMultiplicationAlgorithm::split_and_multiply(A_blocks[0] - A_blocks[2], B_blocks[0] + B_blocks[1]); });
+    products.wait();
     
     // Combine results
     Matrix<T> C11 = P5 + P4 - P2 + P6;
@@ -15,13 +15,17 @@ Matrix<T>* Matrix<T>::WinogradMatrixMultiplicationAlgorithm::compute_from_blocks
     Matrix T3 = B_blocks[3] - B_blocks[1];
     Matrix T4 = T2 - B_blocks[2];
     
-    Matrix P1 = WinogradMatrixMultiplicationAlgorithm::split_and_multiply(A_blocks[0], B_blocks[0]);
-    Matrix P2 = WinogradMatrixMultiplicationAlgorithm::split_and_multiply(A_blocks[1], B_blocks[2]);
-    Matrix P3 = WinogradMatrixMultiplicationAlgorithm::split_and_multiply(S4, B_blocks[3]);
-    Matrix P4 = WinogradMatrixMultiplicationAlgorithm::split_and_multiply(A_blocks[3], T4);
-    Matrix P5 = WinogradMatrixMultiplicationAlgorithm::split_and_multiply(S1, T1);
-    Matrix P6 = WinogradMatrixMultiplicationAlgorithm::split_and_multiply(S2, T2);
-    Matrix P7 = WinogradMatrixMultiplicationAlgorithm::split_and_multiply(S3, T3);
+    // The seven products are independent: blocks large enough run them as tasks
+    Matrix P1, P2, P3, P4, P5, P6, P7;
+    TaskGroup products(A_blocks[0].rows() >= WinogradMatrixMultiplicationAlgorithm::parallel_block_size);
+    products.run([&] { P1 = WinogradMatrixMultiplicationAlgorithm::split_and_multiply(A_blocks[0], B_blocks[0]); });
+    products.run([&] { P2 = WinogradMatrixMultiplicationAlgorithm::split_and_multiply(A_blocks[1], B_blocks[2]); });
+    products.run([&] { P3 = WinogradMatrixMultiplicationAlgorithm::split_and_multiply(S4, B_blocks[3]); });
+    products.run([&] { P4 = WinogradMatrixMultiplicationAlgorithm::split_and_multiply(A_blocks[3], T4); });
+    products.run([&] { P5 = WinogradMatrixMultiplicationAlgorithm::split_and_multiply(S1, T1); });
+    products.run([&] { P6 = WinogradMatrixMultiplicationAlgorithm::split_and_multiply(S2, T2); });
+    products.run([&] { P7 = WinogradMatrixMultiplicationAlgorithm::split_and_multiply(S3, T3); });
+    products.wait();
     
     Matrix U1 = P1 + P2;
     Matrix U2 = P1 + P6;
@@ -9,7 +9,7 @@ void Matrix<T>::randomize(value_type min, value_type max, unsigned seed) {
     std::mt19937 gen(seed);
     std::uniform_real_distribution<value_type> dist(min, max);
     
-    for (size_type i = 0; i < data_.size(); ++i) {
+    for (size_type i = 0; i < count(); ++i) {
         data_[i] = dist(gen);
     }
 }
@@ -19,14 +19,14 @@ void Matrix<T>::randomize_normal(value_type mean, value_type stddev, unsigned se
     std::mt19937 gen(seed);
     std::normal_distribution<value_type> dist(mean, stddev);
     
-    for (size_type i = 0; i < data_.size(); ++i) {
+    for (size_type i = 0; i < count(); ++i) {
         data_[i] = dist(gen);
     }
 }
 
 template<typename T>
 void Matrix<T>::fill(value_type value) {
-    for (size_type i = 0; i < data_.size(); ++i) {
+    for (size_type i = 0; i < count(); ++i) {
         data_[i] = value;
     }
 }
@@ -64,7 +64,7 @@ typename Matrix<T>::value_type Matrix<T>::trace() const {
 template<typename T>
 typename Matrix<T>::value_type Matrix<T>::norm() const {
     value_type sum = 0;
-    for (size_type i = 0; i < data_.size(); ++i) {
+    for (size_type i = 0; i < count(); ++i) {
         sum += data_[i] * data_[i];
     }
     return std::sqrt(sum);
@@ -83,41 +83,163 @@ void Matrix<T>::print(std::ostream& os, int precision) const {
     }
 }
 
+// Text files: "rows cols", then the elements row by row, one row a line.
+// Both directions cut the text into blocks of about a megabyte, one per
+// thread of the TaskScheduler, and go through std::to_chars / std::from_chars: no
+// locale, no stream state, and doubles come back exactly as saved.
+namespace matrix_text {
+
+constexpr size_t block_bytes = 1 << 20;
+
+inline unsigned threads_for(size_t bytes) {
+    size_t threads = TaskScheduler::instance().threads();
+    return (unsigned)std::max<size_t>(1, std::min(threads, bytes / block_bytes));
+}
+
+// blanks, line ends and any other control character
+inline bool is_space(char c) {
+    return (unsigned char)c <= ' ';
+}
+
+// p moved past the token it falls in, so that blocks split between tokens
+inline const char* token_start(const char* begin, const char* p, const char* end) {
+    while (p > begin && p < end && !is_space(p[-1])) {
+        ++p;
+    }
+    return p;
+}
+
+// token starts, p following whitespace or beginning the text; the inner
+// loop has a fixed count so that it vectorizes
+inline size_t count_tokens(const char* p, const char* end) {
+    if (p == end) {
+        return 0;
+    }
+    size_t n = !is_space(*p);
+    for (; end - p > 64; p += 64) {
+        unsigned k = 0;
+        for (int i = 0; i < 64; ++i) {
+            k += is_space(p[i]) & !is_space(p[i + 1]);
+        }
+        n += k;
+    }
+    for (; end - p > 1; ++p) {
+        n += is_space(p[0]) & !is_space(p[1]);
+    }
+    return n;
+}
+
+// the next token into value; p is left just past it
+template<typename V>
+void parse_token(const char*& p, const char* end, V& value) {
+    while (p < end && is_space(*p)) {
+        ++p;
+    }
+    if (p < end && *p == '+') {
+        ++p;
+    }
+    auto r = std::from_chars(p, end, value);
+    if (r.ec != std::errc() || (r.ptr < end && !is_space(*r.ptr))) {
+        throw std::runtime_error("Bad number in matrix file");
+    }
+    p = r.ptr;
+}
+
+// f(0) ... f(n - 1) as tasks of the shared scheduler, the calling thread
+// taking f(0); the first exception thrown is passed on once all are done
+template<typename F>
+void for_each_block(size_t n, F f) {
+    TaskGroup group;
+    for (size_t i = 1; i < n; ++i) {
+        group.run([&f, i] { f(i); });
+    }
+    try {
+        f(0);
+    } catch (...) {
+        group.wait(); // the others still use f
+        throw;
+    }
+    group.wait();
+}
+
+} // namespace matrix_text
+
 template<typename T>
 void Matrix<T>::save_to_file(const std::string& filename) const {
-    std::ofstream file(filename);
+    std::ofstream file(filename, std::ios::binary);
     if (!file.is_open()) {
         throw std::runtime_error("Could not open file: " + filename);
     }
-    
-    file << rows_ << " " << cols_ << std::endl;
-    for (size_type i = 0; i < rows_; ++i) {
-        for (size_type j = 0; j < cols_; ++j) {
-            file << (*this)(i, j);
-            if (j < cols_ - 1) file << " ";
+    file << rows_ << " " << cols_ << "\n";
+
+    // rounds of one block of rows per thread, written in order
+    const size_type block_rows = std::max<size_type>(1, matrix_text::block_bytes / 24 / std::max<size_type>(cols_, 1));
+    const unsigned threads = matrix_text::threads_for(count() * 24);
+    std::vector<std::string> text(threads);
+    for (size_type first = 0; first < rows_; first += block_rows * threads) {
+        matrix_text::for_each_block(threads, [&](size_t t) {
+            std::string& out = text[t];
+            out.clear();
+            char buf[64];
+            size_type begin = std::min(rows_, first + t * block_rows), end = std::min(rows_, begin + block_rows);
+            for (size_type i = begin; i < end; ++i) {
+                const value_type* row = data_ + index(i, 0);
+                for (size_type j = 0; j < cols_; ++j) {
+                    char* stop = std::to_chars(buf, buf + sizeof buf, row[j]).ptr;
+                    *stop++ = (j + 1 < cols_) ? ' ' : '\n';
+                    out.append(buf, stop);
+                }
+            }
+        });
+        for (const auto& out : text) {
+            file.write(out.data(), out.size());
         }
-        file << std::endl;
     }
-    file.close();
+    if (!file) {
+        throw std::runtime_error("Could not write file: " + filename);
+    }
 }
 
 template<typename T>
 Matrix<T> Matrix<T>::load_from_file(const std::string& filename) {
-    std::ifstream file(filename);
+    std::ifstream file(filename, std::ios::binary | std::ios::ate);
     if (!file.is_open()) {
         throw std::runtime_error("Could not open file: " + filename);
     }
-    
+    std::string text((size_t)file.tellg(), '\0');
+    file.seekg(0);
+    file.read(&text[0], text.size());
+    const char* p = text.data();
+    const char* end = p + text.size();
+
     size_type rows, cols;
-    file >> rows >> cols;
-    
+    matrix_text::parse_token(p, end, rows);
+    matrix_text::parse_token(p, end, cols);
     Matrix result(rows, cols);
-    for (size_type i = 0; i < rows; ++i) {
-        for (size_type j = 0; j < cols; ++j) {
-            file >> result(i, j);
-        }
+
+    // elements before each block are counted first, then every block is parsed into place
+    const unsigned threads = matrix_text::threads_for(end - p);
+    std::vector<const char*> cut(threads + 1);
+    for (unsigned t = 0; t <= threads; ++t) {
+        cut[t] = matrix_text::token_start(p, p + (end - p) * t / threads, end);
+    }
+    std::vector<size_t> first(threads + 1, 0);
+    matrix_text::for_each_block(threads, [&](size_t t) {
+        first[t + 1] = matrix_text::count_tokens(cut[t], cut[t + 1]);
+    });
+    for (unsigned t = 0; t < threads; ++t) {
+        first[t + 1] += first[t];
+    }
+    if (first[threads] != result.count()) {
+        throw std::runtime_error("Matrix file holds " + std::to_string(first[threads]) +
+                                 " elements, expected " + std::to_string(result.count()));
     }
-    file.close();
+    matrix_text::for_each_block(threads, [&](size_t t) {
+        const char* q = cut[t];
+        for (size_t k = first[t]; k < first[t + 1]; ++k) {
+            matrix_text::parse_token(q, cut[t + 1], result.data_[k]);
+        }
+    });
     return result;
 }
 
@@ -127,7 +249,7 @@ bool Matrix<T>::is_equal(const Matrix& other, value_type tolerance) const {
         return false;
     }
     
-    for (size_type i = 0; i < data_.size(); ++i) {
+    for (size_type i = 0; i < count(); ++i) {
         if (std::abs(data_[i] - other.data_[i]) > tolerance) {
             return false;
         }
@@ -138,17 +260,20 @@ bool Matrix<T>::is_equal(const Matrix& other, value_type tolerance) const {
 // Data access methods
 template<typename T>
 typename Matrix<T>::value_type* Matrix<T>::data() {
-    return data_.data();
+    return data_;
 }
 
 template<typename T>
 const typename Matrix<T>::value_type* Matrix<T>::data() const {
-    return data_.data();
+    return data_;
 }
 
 template<typename T>
 const std::vector<typename Matrix<T>::value_type>& Matrix<T>::get_data() const {
-    return data_;
+    if (data_ != storage_.data()) {
+        throw std::logic_error("get_data: the elements are borrowed, use data()");
+    }
+    return storage_;
 }
 
 // Free functions
@@ -0,0 +1,128 @@
+#include "core/long.h"
+#include <thread>
+
+// Products of many limbs by a number-theoretic transform modulo the prime
+// p = 29 * 2^57 + 1. Every coefficient of the product is below
+// n * (base - 1)^2, which is less than p up to 4 * 10^10 limbs, so unlike
+// the double FFT of strassen_mul (which starts losing digits at about 10^4
+// limbs) the result is exact.
+
+typedef unsigned __int128 u128;
+
+static const ull ntt_p = 4179340454199820289ull; // 29 * 2^57 + 1
+static const ull ntt_root = 3;                   // generates the multiplicative group
+
+// Montgomery form with R = 2^64: x is kept as x R mod p, a product needs no division
+struct Mont {
+	ull pinv; // -p^-1 mod 2^64
+	ull r2;   // R^2 mod p
+
+	Mont()
+	{
+		ull x = ntt_p; // p^-1 mod 2^64, every step doubles the correct bits
+		for (int i = 0; i < 6; ++i)
+			x *= 2 - ntt_p * x;
+		pinv = -x;
+		ull r = (ull)(((u128)1 << 64) % ntt_p);
+		r2 = (ull)((u128)r * r % ntt_p);
+	}
+	// a b / R mod p
+	ull mul(ull a, ull b) const
+	{
+		u128 t = (u128)a * b;
+		ull m = (ull)t * pinv;
+		ull u = (ull)((t + (u128)m * ntt_p) >> 64);
+		return (u >= ntt_p) ? u - ntt_p : u;
+	}
+	ull to(ull a) const { return mul(a, r2); }
+};
+
+static const Mont mont;
+
+static ull pow_p(ull a, ull e)
+{
+	ull r = 1;
+	for (; e; e >>= 1, a = (ull)((u128)a * a % ntt_p))
+		if (e & 1)
+			r = (ull)((u128)r * a % ntt_p);
+	return r;
+}
+
+// the powers 1, w, w^2, ... of the root of order len (its inverse for inv), in Montgomery form
+static void twiddles(vector<ull>& w, uint len, bool inv)
+{
+	ull wl = pow_p(ntt_root, (ntt_p - 1) / len);
+	if (inv)
+		wl = pow_p(wl, ntt_p - 2);
+	w[0] = mont.to(1);
+	ull wlm = mont.to(wl);
+	for (uint j = 1; j < len / 2; ++j)
+		w[j] = mont.mul(w[j - 1], wlm);
+}
+
+// in place, natural order in, bit-reversed out (Gentleman-Sande)
+static void ntt_forward(vector<ull>& a)
+{
+	uint n = a.size();
+	vector<ull> w(n / 2);
+	for (uint len = n; len >= 2; len >>= 1) {
+		uint half = len >> 1;
+		twiddles(w, len, false);
+		for (uint i = 0; i < n; i += len)
+			for (uint j = 0; j < half; ++j) {
+				ull u = a[i + j], v = a[i + j + half];
+				a[i + j] = (u + v >= ntt_p) ? u + v - ntt_p : u + v;
+				a[i + j + half] = mont.mul((u >= v) ? u - v : u + ntt_p - v, w[j]);
+			}
+	}
+}
+
+// in place, bit-reversed in, natural order out (Cooley-Tukey), unscaled:
+// undoes ntt_forward up to a factor n, so no bit reversal pass is ever made
+static void ntt_inverse(vector<ull>& a)
+{
+	uint n = a.size();
+	vector<ull> w(n / 2);
+	for (uint len = 2; len <= n; len <<= 1) {
+		uint half = len >> 1;
+		twiddles(w, len, true);
+		for (uint i = 0; i < n; i += len)
+			for (uint j = 0; j < half; ++j) {
+				ull u = a[i + j], v = mont.mul(a[i + j + half], w[j]);
+				a[i + j] = (u + v >= ntt_p) ? u + v - ntt_p : u + v;
+				a[i + j + half] = (u >= v) ? u - v : u + ntt_p - v;
+			}
+	}
+}
+
+Long Long::ntt_mul(const Long& b) const
+{
+	Long c = ntt_product(a.data(), size(), b.a.data(), b.size());
+	c.changeSign(sign * b.sign);
+	return c;
+}
+
+Long Long::ntt_product(const ull* x, uint n, const ull* y, uint m)
+{
+	uint len = 1;
+	while (len < n + m)
+		len <<= 1;
+	vector<ull> fa(x, x + n), fb(y, y + m);
+	fa.resize(len, 0);
+	fb.resize(len, 0);
+
+	std::thread ta(ntt_forward, std::ref(fa));
+	ntt_forward(fb);
+	ta.join();
+
+	for (uint i = 0; i < len; ++i)
+		fa[i] = mont.mul(fa[i], fb[i]); // one factor R^-1 too few, put back with 1/len
+	ntt_inverse(fa);
+	ull scale = mont.to(mont.to(pow_p(len, ntt_p - 2)));
+
+	Long c(vector<ull>(len, 0));
+	for (uint i = 0; i < len; ++i)
+		c.set(i, mont.mul(fa[i], scale));
+	c.normal();
+	return c;
+}
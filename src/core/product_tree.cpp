@@ -0,0 +1,71 @@
+#include "core/long.h"
+
+// Product tree: level 0 holds the inputs, every next level the products of
+// neighbouring pairs (an odd one out is carried up), the last level the
+// total product. Balanced products keep both operands of every
+// multiplication the same size, so the fast multiplication tiers apply.
+vector<vector<Long>> product_tree(const vector<Long>& x)
+{
+    vector<vector<Long>> tree(1, x);
+    if (x.empty())
+        return tree;
+
+    while (tree.back().size() > 1) {
+        const auto& prev = tree.back();
+        vector<Long> level;
+        level.reserve((prev.size() + 1) / 2);
+        for (size_t i = 0; i + 1 < prev.size(); i += 2)
+            level.push_back(prev[i] * prev[i + 1]);
+        if (prev.size() & 1)
+            level.push_back(prev.back());
+        tree.push_back(std::move(level));
+    }
+    return tree;
+}
+
+// reduces the root value down the tree: r(child) = r(parent) % child
+static vector<Long> remainder_tree(const Long& x, const vector<vector<Long>>& tree)
+{
+    vector<Long> rem = { x % tree.back()[0] };
+    for (int l = tree.size() - 2; l >= 0; --l) {
+        const auto& level = tree[l];
+        vector<Long> next;
+        next.reserve(level.size());
+        for (size_t i = 0; i < level.size(); ++i) {
+            const Long& r = rem[i / 2];
+            next.push_back((r < level[i]) ? r : r % level[i]);
+        }
+        rem = std::move(next);
+    }
+    return rem;
+}
+
+// x % moduli[i] for all i at once
+vector<Long> multi_mod(const Long& x, const vector<Long>& moduli)
+{
+    if (moduli.empty())
+        return {};
+    return remainder_tree(x, product_tree(moduli));
+}
+
+// Bernstein's batch gcd: gcd(x[i], product of all the other x[j])
+vector<Long> batch_gcd(const vector<Long>& x)
+{
+    if (x.size() < 2)
+        return vector<Long>(x.size(), pone);
+
+    auto tree = product_tree(x);
+    Long prod = tree.back()[0];
+
+    // P mod x[i]^2 through a tree of squares; (P mod x[i]^2) / x[i] == (P / x[i]) mod x[i]
+    for (auto& level : tree)
+        for (auto& v : level)
+            v = v * v;
+    auto rem = remainder_tree(prod, tree);
+
+    vector<Long> res;
+    res.reserve(x.size());
+    for (size_t i = 0; i < x.size(); ++i)
+        res.push_back(gcd(rem[i] / x[i], x[i]));
+    return res;
+}
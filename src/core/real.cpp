@@ -1,62 +1,36 @@
 #include "core/long.h"
 #include "core/real.h"
+#include <stdexcept>
+#include <sstream>
 
 const char* Real::delim_mant = ".";
-std::ostream & operator<<(std::ostream & stream, Real b) {
-	stream << b.operator std::string();
+// written as it goes, see Long::write_digits
+std::ostream & operator<<(std::ostream & stream, const Real& b) {
+	const Long& v = b;
+	if (v < 0 && !v.is_zero())
+		stream.put('-');
+	v.write_digits(stream, b.get_mant(), *Real::delim_mant);
 	return stream;
 }
 Real::operator std::string() const {
-	std::string s = "";
-	if (!sign) s += "-";
-
-	int i = size() - 1, j = real_size();
-	int q = mantissa_place;
-	if (q >= j) {
-		--q;
-		s += "0" + std::string(delim_mant);
-		while (q-- > j)
-			s += "0";
-		while (i >= 0) 
-			s += my_to_string(a[i--], base);
-	}
-	else {
-		s += std::to_string(a[i--]);
-		while (i >= 0) {
-			if (j > static_cast<int>(mantissa_place))
-				for (auto tmp = 0; tmp < static_cast<int>(bs); ++tmp) {
-					if (j - tmp == static_cast<int>(mantissa_place))
-						s += std::string(delim_mant);
-				}
-			else 
-				j -= bs;
-
-			s += my_to_string(a[i--], base);
-		}
-	}
-	return s;
+	std::ostringstream s;
+	s << *this;
+	return s.str();
 }
-Real Real::normalmant()
+// a zero limb below the point is bs zero digits of the fraction
+Real& Real::normalmant()
 {
-	if (mantissa_place == 0)
-		return *this;
-	// int bs = std::log10(base);  // Unused variable removed
-	vector<ull> vec;
-	int j = 0;
-	if (a[0] == 0) {
-		do {
-			++j;
-		} while (j < static_cast<int>(size()) && a[j] == 0); 
-		while (j < static_cast<int>(size()))
-			vec.push_back(a[j++]);
-		a = vec;
-		return normalmant();
+	uint j = 0;
+	while (j + 1 < size() && a[j] == 0 && mantissa_place >= bs) {
+		++j;
+		mantissa_place -= bs;
 	}
-
+	if (j > 0)
+		a.erase(a.begin(), a.begin() + j);
 	return *this;
 }
 
-Real Real::cut(uint t)
+Real& Real::cut(uint t)
 {
 	if (size() >= t) {
 		mantissa_place -= (size() - t) * bs;
@@ -65,81 +39,200 @@ Real Real::cut(uint t)
 	return *this;
 }
 
-Real::Real(const Long & value, uint m) : Long(value), mantissa_place(m) {
+// the top dropped limb decides; a carry may add a limb at the top
+Real& Real::round(uint t)
+{
+	if (size() <= t)
+		return *this;
+	uint drop = std::min(size() - t, mantissa_place / bs);
+	if (drop == 0)
+		return *this;
+	bool up = a[drop - 1] >= base / 2;
+	a.erase(a.begin(), a.begin() + drop);
+	mantissa_place -= drop * bs;
+	if (up)
+		Long::operator=(Long::operator+((sign == 1) ? pone : mone));
+	return normalmant();
+}
+
+Real::Real(const Long & value, uint m) : Long(value), mantissa_place(m), precision(0) {
 	normalmant();
 }
 
-Real Real::operator+(const Real & other) const
+Real::Real(Long && value, uint m) : Long(std::move(value)), mantissa_place(m), precision(0) {
+	normalmant();
+}
+
+// x * 10^digits: whole limbs by a shift, the rest by one limb multiplication
+static Long scale10(const Long& x, uint digits)
 {
-	bool mmant = mantissa_place > other.mantissa_place;
-	Long p1 = (mmant) ? *this : other;
-	Long p2 = (mmant) ? other : *this;
+	static const ull pw[] = { 1, 10, 100, 1000 };
+	if (digits == 0 || x.is_zero())
+		return x;
+	Long r = (digits % Long::bs) ? x.mul_limb(pw[digits % Long::bs]) : x;
+	return r.shift(digits / Long::bs);
+}
 
-	auto m1 = mmant ? mantissa_place : other.mantissa_place;
-	auto m2 = mmant ? other.mantissa_place : mantissa_place;
-	p1 = p1 + p2.shift(m1 - m2);
-	Real p3 = static_cast<Real>(p1);
-	p3.mantissa_place = m1;
-	return p3.normalmant();
+// results keep the precision of the less precise operand; 0 counts as exact
+static uint joint_prec(uint p, uint q)
+{
+	return (p == 0 || q == 0) ? std::max(p, q) : std::min(p, q);
 }
-Real Real::operator-(const Real & other) const {
-	bool mmant = mantissa_place > other.mantissa_place;
-	Long p1 = (mmant) ? *this : other;
-	Long p2 = (mmant) ? other : *this;
-
-	auto m1 = mmant ? mantissa_place : other.mantissa_place;
-	auto m2 = mmant ? other.mantissa_place : mantissa_place;
-	// int bs = std::log10(base);  // Unused variable removed
-	auto t10 = 0; auto t = p2[0];
-	while (t % 10 == 0) {
-		++t10; t = t / 10;
-	}
 
-	int shifting = (m1 - m2 + t10);
-	p1 = mmant ? (p1 - p2.shiftback(shifting)) : (p2.shiftback(shifting) - p1);
-	Real p3 = static_cast<Real>(p1);
-	p3.mantissa_place = m1;       // x(n+1) = xn(2 - b * xn)
-	return p3.normalmant();
+// Below this many limbs + and - build the scaled operand and add on the
+// vector limb kernels; past it the temporaries outgrow the limb pool's
+// largest size class and one lazy pass (long_expr.h) is about 1.5x faster.
+static const uint lazy_add_limbs = 8192;
+
+// x / 10^mx + s * y / 10^my over 10^max(mx, my)
+static Long aligned_sum(const Long& x, uint mx, const Long& y, uint my, int s)
+{
+	static const long long pw[] = { 1, 10, 100, 1000 };
+	uint m = std::max(mx, my), dx = m - mx, dy = m - my;
+	if (std::max(x.size(), y.size()) < lazy_add_limbs)
+		return (s > 0) ? scale10(x, dx) + scale10(y, dy) : scale10(x, dx) - scale10(y, dy);
+	return (lazy(x) * pw[dx % Long::bs]).shift(dx / Long::bs) + (lazy(y) * (s * pw[dy % Long::bs])).shift(dy / Long::bs);
 }
+
+Real Real::operator+(const Real & other) const
+{
+	Real r(aligned_sum(*this, mantissa_place, other, other.mantissa_place, 1), std::max(mantissa_place, other.mantissa_place));
+	r.precision = joint_prec(precision, other.precision);
+	return r;
+}
+Real Real::operator-(const Real & other) const {
+	Real r(aligned_sum(*this, mantissa_place, other, other.mantissa_place, -1), std::max(mantissa_place, other.mantissa_place));
+	r.precision = joint_prec(precision, other.precision);
+	return r;
+}
+// With a precision only its top limbs are computed (Long::mul_high), the
+// fraction digits losing what was not; the integer part is always exact.
 Real Real::operator*(const Real & other) const {
-	Long p1 = Long(*this) * Long(other);
-	Real p2 = static_cast<Real>(p1);
-	p2.mantissa_place = mantissa_place + other.mantissa_place;
-	return p2.normalmant();
+	auto p = joint_prec(precision, other.precision);
+	auto m = mantissa_place + other.mantissa_place;
+	uint drop = 0;
+	if (p != 0 && size() + other.size() > p)
+		drop = std::min(size() + other.size() - p, m / bs);
+
+	Real r(drop ? mul_high(other, drop) : Long::operator*(other), m - drop * bs);
+	r.precision = p;
+	return r;
+}
+
+// v / 10^m, m of either sign
+static Real with_exponent(const Long& v, long long m)
+{
+	if (m >= 0)
+		return Real(v, (uint)m);
+	return Real(scale10(v, (uint)-m), 0);
+}
+
+// this * (1 / other), both two limbs past the quotient, then rounded: an
+// exact quotient comes out exact. Exact operands give as many limbs as the
+// longer one has, and no fewer than div_limbs.
+Real Real::operator/(const Real & other) const {
+	auto p = joint_prec(precision, other.precision);
+	uint limbs = p ? p : std::max({ size(), other.size(), div_limbs });
+	Real inv = reciprocal(other, limbs + 2);
+	Real r = with_exponent(inv, (long long)inv.get_mant() - other.mantissa_place);
+	r.precision = limbs + 2;
+	r = Real(*this, mantissa_place) * r; // the guard limbs must survive a lower precision of this
+	r.round(limbs);
+	r.precision = p;
+	return r;
 }
 
-Real::Real(const Real & other) : Long(other)
+// y = y (3 - x y^2) / 2 from the root of the top digits of x
+Real rsqrt(const Real& x, uint limbs)
 {
-	operator=(other);
+	const Long& v = x;
+	if (v.is_zero() || v < 0)
+		throw std::domain_error("rsqrt: argument must be positive");
+	if (limbs == 0)
+		limbs = x.get_prec() ? x.get_prec() : Real::div_limbs;
+
+	// x ~ t * 10^e with e even; the top five limbs hold 17 digits at least
+	uint n = v.size(), top = std::min(n, 5u);
+	long double t = 0;
+	for (uint i = 0; i < top; ++i)
+		t = t * Long::base + v[n - 1 - i];
+	long long e = (long long)(n - top) * Long::bs - x.get_mant();
+	if (e % 2 != 0) {
+		t *= 10;
+		--e;
+	}
+	long double y0 = 1 / std::sqrt(t);
+	int c = 15 - (int)std::floor(std::log10(y0));
+	Real y = with_exponent(Long((ull)(y0 * std::pow(10.0L, (long double)c))), c + e / 2);
+
+	// x itself as exact, or its precision would cap every step
+	const Real xe(v, x.get_mant()), three(Long(3), 0), half(Long(5), 1);
+	for (uint good = 14; good < (limbs + 1) * Long::bs; ) {
+		good *= 2;
+		y.set_prec(std::min(good / Long::bs, limbs) + 2);
+		y = y * (three - xe * y * y) * half;
+	}
+	y.set_prec(0);
+	return y.round(limbs);
 }
 
-Real::Real(Real && other)
+// x / sqrt(x)
+Real sqrt(const Real& x, uint limbs)
 {
-	operator=(other);
+	const Long& v = x;
+	if (v.is_zero())
+		return Real(null, 0);
+	if (v < 0)
+		throw std::domain_error("sqrt: argument must not be negative");
+	if (limbs == 0)
+		limbs = x.get_prec() ? x.get_prec() : Real::div_limbs;
+
+	Real y = rsqrt(x, limbs + 2);
+	y.set_prec(limbs + 2);
+	Real r = Real(v, x.get_mant()) * y;
+	r.set_prec(0);
+	return r.round(limbs);
 }
 
+Real::Real(const Real & other) : Long(other), mantissa_place(other.mantissa_place), precision(other.precision) {}
+
+Real::Real(Real && other) noexcept : Long(std::move(other)), mantissa_place(other.mantissa_place), precision(other.precision) {}
+
 Real & Real::operator=(const Real & other)
 {
+	Long::operator=(other);
 	mantissa_place = other.mantissa_place;
-	clear();
-	for (auto i : other.a) {
-		a.push_back(i);
-	}
-	sign = other.sign;
-	mantissa_place = other.mantissa_place;
+	precision = other.precision;
 	return *this;
 }
 
-Real & Real::operator=(Real && other) {
-	clear();
-	for (auto i : other.a) {
-		a.push_back(i);
-	}
-	sign = other.sign;
+Real & Real::operator=(Real && other) noexcept
+{
 	mantissa_place = other.mantissa_place;
-	other.clear();
+	precision = other.precision;
+	Long::operator=(std::move(other));
 	return *this;
 }
+
+Real & Real::operator+=(const Real & other)
+{
+	return *this = *this + other;
+}
+
+Real & Real::operator-=(const Real & other)
+{
+	return *this = *this - other;
+}
+
+Real & Real::operator*=(const Real & other)
+{
+	return *this = *this * other;
+}
+
+Real & Real::operator/=(const Real & other)
+{
+	return *this = *this / other;
+}
 Long to_Long(const Real & a)
 {
 	vector<ull> c;
@@ -0,0 +1,278 @@
+#include "core/serialize.h"
+#include <algorithm>
+#include <stdexcept>
+
+namespace serial {
+
+static const unsigned char magic[4] = { 'L', 'N', 'U', 'M' };
+
+static void put(unsigned char* out, uint64_t v, size_t width)
+{
+	for (size_t i = 0; i < width; ++i, v >>= 8)
+		out[i] = (unsigned char)(v & 0xff);
+}
+
+static uint64_t get(const unsigned char* in, size_t width)
+{
+	uint64_t v = 0;
+	for (size_t i = width; i-- > 0; )
+		v = (v << 8) | in[i];
+	return v;
+}
+
+void put_header(unsigned char* out, const Header& h)
+{
+	std::memcpy(out, magic, 4);
+	put(out + 4, version, 2);
+	put(out + 6, h.kind, 2);
+	put(out + 8, h.n, 8);
+	put(out + 16, h.m, 8);
+	put(out + 24, h.p, 4);
+	put(out + 28, h.q, 4);
+}
+
+Header get_header(const unsigned char* in, size_t size, uint16_t kind)
+{
+	if (size < header_size)
+		throw std::runtime_error("deserialize: record cut short");
+	if (std::memcmp(in, magic, 4) != 0)
+		throw std::runtime_error("deserialize: not a LongNums record");
+	if (get(in + 4, 2) != version)
+		throw std::runtime_error("deserialize: unsupported version " + std::to_string(get(in + 4, 2)));
+	Header h = { (uint16_t)get(in + 6, 2), get(in + 8, 8), get(in + 16, 8),
+		(uint32_t)get(in + 24, 4), (uint32_t)get(in + 28, 4) };
+	if (h.kind != kind)
+		throw std::runtime_error("deserialize: record of another kind");
+	return h;
+}
+
+// the bytes of each element reversed, unless the host is little endian already
+static void to_le(unsigned char* out, const unsigned char* in, size_t count, size_t width)
+{
+	if (host_little_endian || width == 1) {
+		std::memcpy(out, in, count * width);
+		return;
+	}
+	for (size_t i = 0; i < count; ++i, in += width, out += width) {
+		if (in == out)
+			std::reverse(out, out + width);
+		else
+			std::reverse_copy(in, in + width, out);
+	}
+}
+
+void put_le(unsigned char* out, const void* in, size_t count, size_t width)
+{
+	to_le(out, static_cast<const unsigned char*>(in), count, width);
+}
+
+void get_le(void* out, const unsigned char* in, size_t count, size_t width)
+{
+	to_le(static_cast<unsigned char*>(out), in, count, width); // its own inverse
+}
+
+void write_le(std::ostream& out, const void* in, size_t count, size_t width)
+{
+	const char* p = static_cast<const char*>(in);
+	if (host_little_endian) {
+		out.write(p, count * width);
+	}
+	else {
+		unsigned char buf[chunk];
+		for (size_t done = 0; done < count; ) {
+			size_t k = std::min(count - done, chunk / width);
+			put_le(buf, p + done * width, k, width);
+			out.write(reinterpret_cast<const char*>(buf), k * width);
+			done += k;
+		}
+	}
+	if (!out)
+		throw std::runtime_error("serialize: write failed");
+}
+
+void read_le(std::istream& in, void* out, size_t count, size_t width)
+{
+	char* p = static_cast<char*>(out);
+	if (!in.read(p, count * width))
+		throw std::runtime_error("deserialize: record cut short");
+	if (!host_little_endian)
+		get_le(p, reinterpret_cast<const unsigned char*>(p), count, width);
+}
+
+void write_header(std::ostream& out, const Header& h)
+{
+	unsigned char buf[header_size];
+	put_header(buf, h);
+	if (!out.write(reinterpret_cast<const char*>(buf), header_size))
+		throw std::runtime_error("serialize: write failed");
+}
+
+Header read_header(std::istream& in, uint16_t kind)
+{
+	unsigned char buf[header_size];
+	if (!in.read(reinterpret_cast<char*>(buf), header_size))
+		throw std::runtime_error("deserialize: record cut short");
+	return get_header(buf, header_size, kind);
+}
+
+std::ofstream open_out(const std::string& filename)
+{
+	std::ofstream file(filename, std::ios::binary);
+	if (!file.is_open())
+		throw std::runtime_error("Could not open file: " + filename);
+	return file;
+}
+
+std::ifstream open_in(const std::string& filename)
+{
+	std::ifstream file(filename, std::ios::binary);
+	if (!file.is_open())
+		throw std::runtime_error("Could not open file: " + filename);
+	return file;
+}
+
+void check_payload(size_t available, uint64_t count, size_t width)
+{
+	if (count > available / width)
+		throw std::runtime_error("deserialize: record cut short");
+}
+
+} // namespace serial
+
+static serial::Header long_header(const Long& x, uint16_t kind)
+{
+	return { kind, x.size(), 0, (x < 0 && !x.is_zero()) ? 1u : 0u, 0 };
+}
+
+static serial::Header real_header(const Real& x)
+{
+	serial::Header h = long_header(x, serial::REAL);
+	h.m = x.get_mant();
+	h.q = x.get_prec();
+	return h;
+}
+
+// the limbs as read, or a runtime_error for one a Long cannot hold
+static Long make_long(const vector<ull>& limbs, const serial::Header& h)
+{
+	for (ull d : limbs)
+		if (d >= Long::base)
+			throw std::runtime_error("deserialize: limb out of range");
+	if (h.p > 1)
+		throw std::runtime_error("deserialize: bad sign");
+	return Long::from_limbs(limbs.data(), (uint)limbs.size(), h.p == 1);
+}
+
+static Real make_real(const vector<ull>& limbs, const serial::Header& h)
+{
+	if (h.m > UINT32_MAX)
+		throw std::runtime_error("deserialize: mantissa place out of range");
+	Real r(make_long(limbs, h), (uint)h.m);
+	r.set_prec(h.q);
+	return r;
+}
+
+static void check_limbs(uint64_t n)
+{
+	if (n == 0 || n > UINT32_MAX)
+		throw std::runtime_error("deserialize: bad limb count");
+}
+
+static void write_record(const Long& x, const serial::Header& h, std::vector<unsigned char>& out)
+{
+	size_t at = out.size();
+	out.resize(at + serial::header_size + x.size() * sizeof(ull));
+	serial::put_header(out.data() + at, h);
+	serial::put_le(out.data() + at + serial::header_size, x.container().data(), x.size(), sizeof(ull));
+}
+
+static void write_record(const Long& x, const serial::Header& h, std::ostream& out)
+{
+	serial::write_header(out, h);
+	serial::write_le(out, x.container().data(), x.size(), sizeof(ull));
+}
+
+static vector<ull> read_limbs(const unsigned char* data, size_t size, const serial::Header& h)
+{
+	check_limbs(h.n);
+	serial::check_payload(size - serial::header_size, h.n, sizeof(ull));
+	vector<ull> limbs(h.n);
+	serial::get_le(limbs.data(), data + serial::header_size, h.n, sizeof(ull));
+	return limbs;
+}
+
+static vector<ull> read_limbs(std::istream& in, const serial::Header& h)
+{
+	check_limbs(h.n);
+	return serial::read_le_vector<ull>(in, h.n);
+}
+
+void serialize(const Long& x, std::vector<unsigned char>& out)
+{
+	write_record(x, long_header(x, serial::LONG), out);
+}
+
+void serialize(const Long& x, std::ostream& out)
+{
+	write_record(x, long_header(x, serial::LONG), out);
+}
+
+void serialize(const Long& x, const std::string& filename)
+{
+	std::ofstream file = serial::open_out(filename);
+	serialize(x, file);
+}
+
+size_t deserialize(const unsigned char* data, size_t size, Long& x)
+{
+	serial::Header h = serial::get_header(data, size, serial::LONG);
+	x = make_long(read_limbs(data, size, h), h);
+	return serial::header_size + h.n * sizeof(ull);
+}
+
+void deserialize(std::istream& in, Long& x)
+{
+	serial::Header h = serial::read_header(in, serial::LONG);
+	x = make_long(read_limbs(in, h), h);
+}
+
+void deserialize(const std::string& filename, Long& x)
+{
+	std::ifstream file = serial::open_in(filename);
+	deserialize(file, x);
+}
+
+void serialize(const Real& x, std::vector<unsigned char>& out)
+{
+	write_record(x, real_header(x), out);
+}
+
+void serialize(const Real& x, std::ostream& out)
+{
+	write_record(x, real_header(x), out);
+}
+
+void serialize(const Real& x, const std::string& filename)
+{
+	std::ofstream file = serial::open_out(filename);
+	serialize(x, file);
+}
+
+size_t deserialize(const unsigned char* data, size_t size, Real& x)
+{
+	serial::Header h = serial::get_header(data, size, serial::REAL);
+	x = make_real(read_limbs(data, size, h), h);
+	return serial::header_size + h.n * sizeof(ull);
+}
+
+void deserialize(std::istream& in, Real& x)
+{
+	serial::Header h = serial::read_header(in, serial::REAL);
+	x = make_real(read_limbs(in, h), h);
+}
+
+void deserialize(const std::string& filename, Real& x)
+{
+	std::ifstream file = serial::open_in(filename);
+	deserialize(file, x);
+}
@@ -0,0 +1,52 @@
+#include "core/long.h"
+
+// Short products: only the top limbs of x * y are wanted, so the schoolbook
+// columns that land below them are never computed, about half the work.
+// Mulders' split into a smaller full product plus two short ones pays off over
+// Karatsuba, but Long's products above toom3naive limbs are FFTs already, so
+// past short_naive limbs the full product is made and its low limbs dropped.
+// The helpers return |x| * |y| / base^d, never too large and short of the
+// truth by fewer units than there are limbs.
+
+static const uint short_naive = 600; // limbs; up to here the skipped columns beat the FFT product
+
+// t / base^k, truncated
+static Long drop_limbs(const Long& t, uint k)
+{
+	if (k >= t.size())
+		return null;
+	return Long::from_limbs(t.container().data() + k, t.size() - k);
+}
+
+// the columns from d - 1 up; what the lower columns carry is dropped
+static Long short_mul(const ull* x, uint nx, const ull* y, uint ny, uint d)
+{
+	uint s = d - 1;
+	vector<ull> col(nx + ny - s, 0);
+	for (uint i = 0; i < nx; ++i)
+		for (uint j = (s > i) ? s - i : 0; j < ny; ++j)
+			col[i + j - s] += x[i] * y[j];
+	ull carry = 0;
+	for (auto& c : col) {
+		c += carry;
+		carry = c / Long::base;
+		c %= Long::base;
+	}
+	return Long::from_limbs(col.data() + 1, col.size() - 1);
+}
+
+Long Long::mul_high(const Long& b, uint drop) const
+{
+	// two guard limbs take the error of the skipped columns, then go as well
+	const uint guard = 2;
+	Long r = null;
+	if (drop >= size() + b.size())
+		return r;
+	else if (drop <= guard || std::min(size(), b.size()) > short_naive)
+		r = drop_limbs(abs(*this) * abs(b), drop);
+	else
+		r = drop_limbs(short_mul(a.data(), size(), b.a.data(), b.size(), drop - guard), guard);
+	if (!r.is_zero())
+		r.changeSign(sign * b.sign);
+	return r;
+}
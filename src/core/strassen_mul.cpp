@@ -13,7 +13,7 @@ struct fft {
 Long Long::strassen_mul(const Long & b) const
 {
 	if (size() < strasnaive && b.size() < strasnaive)
-		return operator*(b);
+		return karac_mul(b);
 	vector<ReIm> fa(a.begin(), a.end()), fb(b.a.begin(), b.a.end());
 	uint n = 1;
 	int flag = (sign * b.sign);
@@ -46,7 +46,8 @@ Long Long::strassen_mul(const Long & b) const
 	for (uint i = 0; i < n; ++i)
 		c.set(i, ull(fa[i].real() + 0.5));
 
-	return c.normal().changeSign(flag);
+	c.normal().changeSign(flag);
+	return c;
 }
 
 
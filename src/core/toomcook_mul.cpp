@@ -54,7 +54,7 @@ Long Long::toomcook_mul(const Long & b) const
 		a[1] = b[0];					 // 0
 		a[2] = a[0] + b[1];				 // 1 
 		a[3] = a[0] - b[1];				 // -1 
-		a[4] = (a[3] + b[2]) * 2 - b[0]; // -2
+		a[4] = (lazy(a[3]) + b[2]) * 2 - b[0]; // -2
 		a[5] = b[2];                     // inf 
 	};
 
@@ -89,18 +89,22 @@ Long Long::toomcook_mul(const Long & b) const
 
 	Res[0] = R[0];
 	Res[4] = R[4];
-	Res[3] = (R[3] - R[1]) / 3;
-	Res[1] = (R[1] - R[2]) / 2;
-	Res[2] = R[2] - R[0];
-	Res[3] = (Res[2] - Res[3]) / 2 + R[4] * 2;
-	Res[2] = Res[2] + Res[1] - Res[4];
-	Res[1] = Res[1] - Res[3];
+	Res[3] = Long(lazy(R[3]) - R[1]) / 3;
+	Res[1] = Long(lazy(R[1]) - R[2]) / 2;
+	Res[2] = lazy(R[2]) - R[0];
+	Res[3] = Long(lazy(Res[2]) - Res[3]) / 2;
+	Res[3] = lazy(Res[3]) + lazy(R[4]) * 2;
+	Res[2] = lazy(Res[2]) + Res[1] - Res[4];
+	Res[1] = lazy(Res[1]) - Res[3];
 #ifdef DEBUG
 	for (auto i : Res) {
 		std::cout << i << "    ";
 	}
 	std::cout << std::endl;
 #endif // DEBUG
-	return (((Res[4].insert(vector<ull>(km + km, 0)) + Res[2]).insert(vector<ull>(km + km, 0)) + Res[0]
-		+ (Res[3].insert(vector<ull>(km + km, 0)) + Res[1]).insert(vector<ull>(km, 0))).changeSign(fl));
+	// one pass over all five coefficients instead of a chain of shifted temporaries
+	Long c = lazy(Res[4]).shift(4 * km) + lazy(Res[3]).shift(3 * km) + lazy(Res[2]).shift(2 * km)
+		+ lazy(Res[1]).shift(km) + Res[0];
+	c.changeSign(fl);
+	return c;
 }
\ No newline at end of file
@@ -28,7 +28,7 @@ int main() {
 
     // Test 2: Large number construction
     cout << "2. Large number construction:" << endl;
-    Long large_number = Long("12345678901234567890");
+    Long large_number = 12345678901234567890_L;
     cout << "   Large number: " << large_number << endl << endl;
 
     // Test 3: Multiplication algorithm comparison
@@ -99,8 +99,8 @@ int main() {
 
     // Test 8: Large number operations
     cout << "8. Large number operations:" << endl;
-    Long big_num1 = Long("123456789");
-    Long big_num2 = Long("987654321");
+    Long big_num1 = 123456789_L;
+    Long big_num2 = 987654321_L;
     cout << "   Big number 1: " << big_num1 << endl;
     cout << "   Big number 2: " << big_num2 << endl;
     cout << "   Sum: " << big_num1 + big_num2 << endl;
@@ -108,8 +108,8 @@ int main() {
 
     // Test 9: Performance test with larger numbers
     cout << "9. Performance test with larger numbers:" << endl;
-    Long perf_num1 = Long("123456789012345");
-    Long perf_num2 = Long("987654321098765");
+    Long perf_num1 = 123456789012345_L;
+    Long perf_num2 = 987654321098765_L;
     
     auto start = chrono::high_resolution_clock::now();
     Long perf_result = perf_num1 * perf_num2;
@@ -137,8 +137,8 @@ int main() {
 
     // Test 11: Stress test with very large numbers
     cout << "11. Stress test with very large numbers:" << endl;
-    Long stress_num1 = Long("123456789012345678901234567890");
-    Long stress_num2 = Long("987654321098765432109876543210");
+    Long stress_num1 = 123456789012345678901234567890_L;
+    Long stress_num2 = 987654321098765432109876543210_L;
     
     start = chrono::high_resolution_clock::now();
     Long stress_result = stress_num1 * stress_num2;
@@ -151,7 +151,7 @@ int main() {
 
     // Test 12: Random number generation test
     cout << "12. Random number generation test:" << endl;
-    Long max_rand = Long("1000000000000");
+    Long max_rand = 1000000000000_L;
     cout << "   Generating 5 random numbers up to " << max_rand << ":" << endl;
     for (int i = 0; i < 5; ++i) {
         Long random_num = rand(max_rand.size(), max_rand);
@@ -159,6 +159,31 @@ int main() {
     }
     cout << endl;
 
+    // Test 13: Division with negative operands
+    // q is truncated toward zero and r = |a| mod |b|, so a = q * b + sign(a) * r
+    cout << "13. Signed division:" << endl;
+    Long big_dividend = pow(Long(10), Long(130)) + 12345;
+    Long big_divisor = pow(Long(10), Long(40)) + 7;
+    int division_failures = 0;
+    for (const Long& x : {big_dividend, big_divisor, Long(175)}) {
+        for (const Long& y : {Long(175), big_divisor, big_dividend}) {
+            for (int sx : {1, -1}) {
+                for (int sy : {1, -1}) {
+                    Long num = x * Long(sx), den = y * Long(sy), r = null;
+                    Long q = num.divide(den, r);
+                    bool ok = q * den + r * Long(num < 0 ? -1 : 1) == num && !(r < 0) && r < abs(den) &&
+                              (q.is_zero() || (q < 0) == ((num < 0) != (den < 0)));
+                    division_failures += ok ? 0 : 1;
+                }
+            }
+        }
+    }
+    Long r175 = null;
+    cout << "   -10^130 / 175 = " << string((big_dividend * Long(-1)).divide(Long(175), r175)).substr(0, 20) << "..., remainder " << r175 << endl;
+    cout << "   " << (division_failures == 0 ? "All 36 sign combinations check out" : "FAILED sign combinations: " + to_string(division_failures)) << endl << endl;
+    if (division_failures != 0)
+        return 1;
+
     // Simple 4x4 diagonal matrices multiplied using AlphaTensor algorithm
     cout << "\n12+. Matrix AlphaTensor 4x4 diagonal test:" << endl;
     Matrix<double> A(4, 4);
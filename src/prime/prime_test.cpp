@@ -1,4 +1,5 @@
 #include "core/long.h"
+#include <stdexcept>
 
 struct PrimeTest {
 	static double not_prime;
@@ -15,44 +16,153 @@ Long Rab_MilTest::b = null;
 Long Rab_MilTest::m = null;
 double PrimeTest::not_prime = 1.;
 
-//calculates Jacobian(a/n) n>0 and n is odd
-Long Jacobi(Long& a, Long& n) {
-	if (a == null)
-		return null; // (0/n) = 0
+static ull to_ull(const Long& x) {
+	ull r = 0;
+	for (int i = x.size() - 1; i >= 0; --i)
+		r = r * Long::base + x[i];
+	return r;
+}
+
+// (2/d) == -1 iff d = 3, 5 (mod 8)
+static inline bool two_flips(ull d) {
+	return ((d & 7) == 3 || (d & 7) == 5);
+}
+
+// classic binary Jacobi on machine words: strips all the 2s of a in one shift
+static int jacobi_u64(ull a, ull n, int s) {
+	a %= n;
+	while (a != 0) {
+		int e = __builtin_ctzll(a);
+		a >>= e;
+		if ((e & 1) && two_flips(n))
+			s = -s;
+		if (a & n & 2)        // both are 3 (mod 4)
+			s = -s;
+		swap(a, n);
+		a %= n;
+	}
+	return (n == 1) ? s : 0;
+}
+
+// One Euclidean step u' = u - q * v on the pair (u, v), u >= v, where exactly
+// one of u, v is the (odd) denominator of the tracked symbol s * (N/D).
+// Only the low words ul, vl, tl = u' mod 2^64 are needed to update s:
+//   N -= q * D leaves (N/D) as is;
+//   D' = D - q * N with N = 2^e * N'' gives
+//     (N/D) = (2/D)^e (2/D')^e (-1)^((N''-1)/2 * ((D-1)/2 + (D'-1)/2)) (N/D')  for odd D',
+//     (N/D) = (-1)^((N-1)/2 * (D-1)/2) (D'/N)                                  for even D'.
+// After the step the pair becomes (v, u'); returns false if vl has no set bit.
+static bool jacobi_step(bool& den_is_u, int& s, ull ul, ull vl, ull tl) {
+	if (!den_is_u) {
+		den_is_u = true;
+		return true;
+	}
+	if (tl & 1) {
+		if (vl == 0)
+			return false;
+		int e = __builtin_ctzll(vl);
+		ull n2 = vl >> e;
+		if ((e & 1) && (two_flips(ul) != two_flips(tl)))
+			s = -s;
+		if ((n2 & 2) && (((ul ^ tl) & 2) != 0))
+			s = -s;
+		den_is_u = false;
+	}
+	else {
+		if (vl & ul & 2)
+			s = -s;
+		den_is_u = true;
+	}
+	return true;
+}
+
+// Lehmer's algorithm: runs the Euclidean steps of (u, v) on the leading limbs,
+// updating the symbol state from the low words, and applies the collected
+// cofactors to u, v in a single pass. Returns false if no step was possible.
+static bool jacobi_lehmer(Long& u, Long& v, bool& den_is_u, int& s) {
+	const uint lead = 4;   // base^4 < 2^54, so the cofactor sums fit into long long
+	uint k = u.size() - lead;
+	if (v.size() <= k)
+		return false;
+
+	long long uh = 0, vh = 0;
+	for (int i = u.size() - 1; i >= static_cast<int>(k); --i) {
+		uh = uh * Long::base + u[i];
+		vh = vh * Long::base + v[i];
+	}
+
+	ull ul = u.low_bits(), vl = v.low_bits();
+	long long A = 1, B = 0, C = 0, D = 1;
+	while (vh + C != 0 && vh + D != 0) {
+		long long q = (uh + A) / (vh + C);
+		if (q != (uh + B) / (vh + D))
+			break;
 
-	Long ans = pone;
-	if (a < null) {
-		a = a * -1;    // (a/n) = (-a/n)*(-1/n)
-		if (n % 4 == 3)
-			ans = ans * -1; // (-1/n) = -1 if n = 3 ( mod 4 ) 
+		ull tl = ul - (ull)q * vl;
+		if (!jacobi_step(den_is_u, s, ul, vl, tl))
+			break;
+		ul = vl; vl = tl;
+
+		long long t = A - q * C; A = C; C = t;
+		t = B - q * D; B = D; D = t;
+		t = uh - q * vh; uh = vh; vh = t;
 	}
-	if (a == pone)
-		return ans; // (1/n) = 1
-
-	while (a > null) {
-		if (a < null) {
-			a = a * -1;    // (a/n) = (-a/n)*(-1/n)
-			if (n % 4 == 3)
-				ans = ans * -1;    // (-1/n) = -1 if n = 3 ( mod 4 )
+	if (B == 0)
+		return false;
+
+	// the cofactors of each row have opposite signs, and both results are >= 0
+	auto comb = [](long long x, const Long& u, long long y, const Long& v) {
+		return (y <= 0) ? Long((ull)x) * u - Long((ull)-y) * v
+		                : Long((ull)y) * v - Long((ull)-x) * u;
+	};
+	Long nu = comb(A, u, B, v);
+	v = comb(C, u, D, v);
+	u = nu;
+	return true;
+}
+
+// calculates Jacobi symbol (a/n), n > 0 and n is odd
+int Jacobi(const Long& a, const Long& n) {
+	if (n <= null || iseven(n))
+		throw std::invalid_argument("Jacobi: n must be positive and odd");
+
+	int s = 1;
+	Long m = a;
+	m.changeSign(1);
+	if (a < null && (n[0] & 3) == 3)
+		s = -s;   // (-1/n) = -1 if n = 3 ( mod 4 )
+
+	// (u, v) with u >= v, one of them is the denominator
+	bool den_is_u = (m < n);
+	Long u = den_is_u ? n : m;
+	Long v = den_is_u ? m : n;
+
+	while (v != null) {
+		if (u.size() <= 4) {   // base^4 < 2^64
+			ull uw = to_ull(u), vw = to_ull(v);
+			return den_is_u ? jacobi_u64(vw, uw, s) : jacobi_u64(uw, vw, s);
 		}
-		while (iseven(a)) {
-			a = a / 2;    // Property (iii)
-			if (n % 8 == 3 || n % 8 == 5)
-				ans = ans * -1;
+		if (jacobi_lehmer(u, v, den_is_u, s))
+			continue;
+
+		Long t = u - (u / v) * v;
+		ull vl = v.low_bits();
+		if (vl == 0 && den_is_u) {
+			// numerator divisible by 2^64: take e and N'' from the full value
+			uint e = v.ctz();
+			vl = (v >> e).low_bits() << (e & 1);   // keeps the parity of e and N'' mod 4
 		}
-		swap(a, n);    // Property (iv)
-		if (a % 4 == 3 && n % 4 == 3)
-			ans = ans * -1; // Property (iv)
-		a = a%n; // because (a/p) = (a%p / p ) and 
-				 // a%pi = (a%n)%pi if n % pi = 0
-		if (a > n / 2)
-			a = a - n;
+		jacobi_step(den_is_u, s, u.low_bits(), vl, t.low_bits());
+		u = v;
+		v = t;
 	}
-	if (n == pone)
-		return ans;
-	return null;
+	return (u == pone) ? s : 0;
 }
+
 double PrimeTest::SolovStras_met(Long & a, const Long & p) {
+	if (iseven(p)) // Jacobi needs an odd modulus; 2 is the only even prime
+		return not_prime = (p == 2) ? not_prime * 0.5 : -1;
+
 	if (gcd(a, p) > pone)
 		not_prime *= -1;
 
@@ -60,9 +170,8 @@ double PrimeTest::SolovStras_met(Long & a, const Long & p) {
 		return -1;
 
 	Long j = pow_mod(a, (p - 1) / 2, p);
-	auto _p = p;
-	Long Jac = (p + Jacobi(a, _p)) % p;
-	if (Jac == null || j != Jac)
+	int jac = Jacobi(a, p);
+	if (jac == 0 || j != ((jac == 1) ? pone : p - 1))
 		not_prime = -1;
 	else
 		not_prime *= 0.5;
@@ -148,19 +257,11 @@ double prtest_Lehmann(const Long & p, ull iter)
 }
 double prtest_RabinMiller(const Long & p, ull iter)
 {
-	// b == how many times 2 divides p - 1 
-	Rab_MilTest::b = pow(Long(2), [](const Long& p) -> Long {
-		Long counter = null;
-		for (uint i = 0; i < p.size(); ++i) {
-			auto t = p[i];
-			while (t && (t & 1) == 0) {
-				t >>= 1; counter = counter + 1;
-			}
-			if (t != 0) break;
-		}
-		return counter;
-	}(p - 1));
+	// b == how many times 2 divides p - 1
 	// m : p = 1 + 2^b  * m
-	Rab_MilTest::m = (p - 1) / Rab_MilTest::b;
+	Long pm = p - 1;
+	uint s = pm.ctz();
+	Rab_MilTest::b = Long(s);
+	Rab_MilTest::m = pm >> s;
 	return prtest_general(p, iter, &(Rab_MilTest::RabinMiller_met));
 }
\ No newline at end of file